@@ -0,0 +1,668 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
+#include "../ui/layout/adaptive/adaptive_cache.hpp"
+#include "Router.h"
+#include "protocols/rendering/render_queue.hpp"
+#include "timing/clock.hpp"
+#include "timing/frame_pacer.hpp"
+#include "wayland/compositor.hpp"
+#include "../input/methods/touch/touch.hpp"
+#include "../gui_mod/include/gesture.h"
+
+namespace adaptive = palisade::gui::layout::adaptive;
+namespace pacing = palisade::gui::time;
+namespace wayland = palisade::gui::wayland;
+namespace proto = palisade::gui::protocol::render;
+namespace touch = palisade::gui::touch;
+
+namespace palisade::gui::render::gpu {
+proto::CommandSink* activeBackend();    // gpu_fallback.cpp
+}
+
+namespace palisade::gui::render::framebuffer {
+void configure(int w, int h);           // fb_surface.cpp
+uint32_t* pixels();
+int getWidth();
+int getHeight();
+int getStride();
+void markDirty();
+}
+
+namespace gpu = palisade::gui::render::gpu;
+namespace framebuffer = palisade::gui::render::framebuffer;
+
+enum class DeviceClass {
+    Desktop,
+    Phone
+};
+
+struct Vec2 {
+    float x;
+    float y;
+};
+
+struct Rect {
+    Vec2 position;
+    Vec2 size;
+};
+
+class Clock {
+public:
+    static float timeSeconds() {
+        static uint64_t start = pacing::now();
+        return (pacing::now() - start) / 1e9f;
+    }
+};
+
+class SunlightState {
+public:
+    float angle;
+    float intensity;
+
+    SunlightState() : angle(0.0f), intensity(1.0f) {}
+
+    void update(float time) {
+        angle = std::fmod(time * 6.0f, 360.0f);
+        intensity = 0.6f + 0.4f * std::sin(time * 0.5f);
+    }
+};
+
+// A node's shadow: the rect swept along the light direction (convex hull of
+// the rect and its offset copy), with a soft-edged coverage mask rasterized
+// at 1/kMaskScale resolution. Both are cached until the rect changes or the
+// light moves past the registry's threshold.
+class ShadowHandle {
+public:
+    int id;
+    Rect bounds;
+    Rect projected;                 // Shadow extent in screen space
+    std::vector<uint8_t> mask;
+    int maskW = 0;
+    int maskH = 0;
+    bool rectDirty = true;
+    uint32_t lightEpoch = 0;        // Light state the cache was built for
+
+    ShadowHandle(int i, const Rect& r) : id(i), bounds(r) {}
+};
+
+struct ShadowStats {
+    uint64_t frames;
+    uint64_t projections;
+    uint64_t maskPixels;            // Rasterized
+    uint64_t fullPassPixels;        // What re-projecting everything per frame would cost
+};
+
+class ShadowRegistry {
+    std::vector<ShadowHandle> shadows;
+    int nextId = 1;
+
+    float angleThreshold = 2.0f;    // Degrees of light movement before re-projection
+    size_t lightBudget = 4;         // Light-driven re-projections per frame
+    float lightAngle = 0.0f;
+    uint32_t epoch = 0;             // Bumped when the light passes the threshold
+    size_t cursor = 0;
+    ShadowStats stats{};
+
+    static constexpr float kShadowLength = 24.0f;
+    static constexpr float kSoftness = 8.0f;
+    static constexpr int kMaskScale = 4;
+
+    static float angleDelta(float a, float b) {
+        return std::fabs(std::fmod(a - b + 540.0f, 360.0f) - 180.0f);
+    }
+
+    void project(ShadowHandle& s) {
+        float rad = lightAngle * 3.14159265f / 180.0f;
+        Vec2 off{std::cos(rad) * kShadowLength, std::sin(rad) * kShadowLength};
+        const Rect& b = s.bounds;
+
+        // An empty rect casts no shadow (and would give zero-length hull edges)
+        if (!(b.size.x > 0.0f && b.size.y > 0.0f)) {
+            s.projected = {b.position, {0.0f, 0.0f}};
+            s.mask.clear();
+            s.maskW = s.maskH = 0;
+            s.rectDirty = false;
+            s.lightEpoch = epoch;
+            return;
+        }
+
+        // Hull of the rect and its offset copy (monotone chain, counter-clockwise
+        // in y-up terms, so (ey, -ex) is the outward normal)
+        Vec2 pts[8];
+        int n = 0;
+        for (int k = 0; k < 2; k++) {
+            float dx = k ? off.x : 0.0f, dy = k ? off.y : 0.0f;
+            pts[n++] = {b.position.x + dx, b.position.y + dy};
+            pts[n++] = {b.position.x + b.size.x + dx, b.position.y + dy};
+            pts[n++] = {b.position.x + b.size.x + dx, b.position.y + b.size.y + dy};
+            pts[n++] = {b.position.x + dx, b.position.y + b.size.y + dy};
+        }
+        std::sort(pts, pts + 8, [](const Vec2& p, const Vec2& q) {
+            return p.x < q.x || (p.x == q.x && p.y < q.y);
+        });
+        auto cross = [](const Vec2& o, const Vec2& a, const Vec2& c) {
+            return (a.x - o.x) * (c.y - o.y) - (a.y - o.y) * (c.x - o.x);
+        };
+        Vec2 hull[16];
+        int h = 0;
+        for (int i = 0; i < 8; i++) {
+            while (h >= 2 && cross(hull[h - 2], hull[h - 1], pts[i]) <= 0) h--;
+            hull[h++] = pts[i];
+        }
+        for (int i = 6, lower = h + 1; i >= 0; i--) {
+            while (h >= lower && cross(hull[h - 2], hull[h - 1], pts[i]) <= 0) h--;
+            hull[h++] = pts[i];
+        }
+        h--;
+
+        float minX = std::min(b.position.x, b.position.x + off.x) - kSoftness;
+        float minY = std::min(b.position.y, b.position.y + off.y) - kSoftness;
+        float maxX = std::max(b.position.x, b.position.x + off.x) + b.size.x + kSoftness;
+        float maxY = std::max(b.position.y, b.position.y + off.y) + b.size.y + kSoftness;
+        s.projected = {{minX, minY}, {maxX - minX, maxY - minY}};
+
+        // Coverage from the max signed edge distance (a convex polygon SDF,
+        // exact along edges, slightly rounded corners)
+        s.maskW = std::max(1, static_cast<int>(std::ceil((maxX - minX) / kMaskScale)));
+        s.maskH = std::max(1, static_cast<int>(std::ceil((maxY - minY) / kMaskScale)));
+        s.mask.resize(static_cast<size_t>(s.maskW) * s.maskH);
+        float nx[16], ny[16], nd[16];
+        for (int i = 0; i < h; i++) {
+            const Vec2& a = hull[i];
+            const Vec2& c = hull[(i + 1) % h];
+            float ex = c.x - a.x, ey = c.y - a.y;
+            float len = std::sqrt(ex * ex + ey * ey);
+            nx[i] = ey / len;
+            ny[i] = -ex / len;
+            nd[i] = nx[i] * a.x + ny[i] * a.y;
+        }
+        for (int y = 0; y < s.maskH; y++) {
+            float py = minY + (y + 0.5f) * kMaskScale;
+            for (int x = 0; x < s.maskW; x++) {
+                float px = minX + (x + 0.5f) * kMaskScale;
+                float d = -1e9f;
+                for (int i = 0; i < h; i++) d = std::max(d, nx[i] * px + ny[i] * py - nd[i]);
+                float cover = std::min(1.0f, std::max(0.0f, 0.5f - d / (2.0f * kSoftness)));
+                s.mask[static_cast<size_t>(y) * s.maskW + x] = static_cast<uint8_t>(cover * 255.0f);
+            }
+        }
+
+        s.rectDirty = false;
+        s.lightEpoch = epoch;
+        stats.projections++;
+        stats.maskPixels += s.mask.size();
+    }
+
+public:
+    int registerShadow(const Rect& r) {
+        shadows.emplace_back(nextId, r);
+        return nextId++;
+    }
+
+    void updateShadow(int id, const Rect& r) {
+        if (id >= 1 && id <= static_cast<int>(shadows.size())) {
+            ShadowHandle& s = shadows[id - 1];  // Ids are handed out sequentially from 1
+            if (std::memcmp(&s.bounds, &r, sizeof(Rect)) == 0) return;
+            s.bounds = r;
+            s.rectDirty = true;
+        }
+    }
+
+    void setAngleThreshold(float degrees) {
+        angleThreshold = degrees;
+    }
+
+    void setLightBudget(size_t perFrame) {
+        lightBudget = perFrame ? perFrame : 1;
+    }
+
+    // Once per frame after layout. Moved nodes re-project immediately; light
+    // movement past the threshold re-projects round-robin, lightBudget per
+    // frame, while the rest keep their previous (nearby) projection.
+    void refresh(const SunlightState& light) {
+        stats.frames++;
+        if (epoch == 0 || angleDelta(light.angle, lightAngle) >= angleThreshold) {
+            lightAngle = light.angle;
+            epoch++;
+        }
+
+        for (auto& s : shadows) {
+            if (s.rectDirty) project(s);
+            stats.fullPassPixels += s.mask.size();
+        }
+
+        size_t done = 0;
+        for (size_t i = 0; i < shadows.size() && done < lightBudget; i++) {
+            ShadowHandle& s = shadows[(cursor + i) % shadows.size()];
+            if (s.lightEpoch != epoch) {
+                project(s);
+                done++;
+            }
+        }
+        if (!shadows.empty()) cursor = (cursor + done) % shadows.size();
+    }
+
+    const ShadowStats& getStats() const {
+        return stats;
+    }
+
+    const std::vector<ShadowHandle>& getShadows() const {
+        return shadows;
+    }
+};
+
+// Nodes keep the rect they were given (rect) apart from the rect layout computed
+// from it (layoutRect), so layout is idempotent. setRect/addChild mark the node
+// dirty and flag every ancestor, so a pass only descends into dirty subtrees.
+class LayoutNode {
+protected:
+    Rect rect;
+    Rect layoutRect;
+    std::vector<std::shared_ptr<LayoutNode>> children;
+    LayoutNode* parent = nullptr;
+    int shadowId = -1;
+    ShadowRegistry* shadowRegistry = nullptr;
+    uint32_t nodeId;
+    bool dirty = true;          // This node's own rect must be recomputed
+    bool subtreeDirty = true;   // This node or a descendant is dirty
+
+    static uint32_t nextNodeId;
+
+    // Computes layoutRect from rect; must not read layoutRect
+    virtual Rect measure(DeviceClass device) {
+        (void)device;
+        return rect;
+    }
+
+    void markSubtreeDirty() {
+        subtreeDirty = true;
+        for (LayoutNode* n = parent; n && !n->subtreeDirty; n = n->parent) {
+            n->subtreeDirty = true;
+        }
+    }
+
+public:
+    static size_t measuredCount;  // Nodes recomputed by layout passes, for stats
+
+    LayoutNode() : nodeId(nextNodeId++) {}
+    virtual ~LayoutNode() = default;
+
+    void setRect(const Rect& r) {
+        rect = r;
+        invalidate();
+    }
+
+    const Rect& getRect() const {
+        return rect;
+    }
+
+    const Rect& getLayoutRect() const {
+        return layoutRect;
+    }
+
+    void addChild(const std::shared_ptr<LayoutNode>& node) {
+        node->parent = this;
+        children.push_back(node);
+        node->markSubtreeDirty();
+    }
+
+    void invalidate() {
+        dirty = true;
+        adaptive::invalidate(nodeId);
+        markSubtreeDirty();
+    }
+
+    bool needsLayout() const {
+        return subtreeDirty;
+    }
+
+    void layout(DeviceClass device) {
+        if (!subtreeDirty) return;
+
+        if (dirty) {
+            adaptive::CachedRect c;
+            int deviceClass = static_cast<int>(device);
+            if (adaptive::lookup(nodeId, deviceClass, c)) {
+                layoutRect = {{c.x, c.y}, {c.w, c.h}};
+            } else {
+                layoutRect = measure(device);
+                measuredCount++;
+                adaptive::store(nodeId, deviceClass, {layoutRect.position.x, layoutRect.position.y,
+                                                      layoutRect.size.x, layoutRect.size.y});
+            }
+            if (shadowRegistry) shadowRegistry->updateShadow(shadowId, layoutRect);
+            dirty = false;
+        }
+
+        for (auto& c : children) {
+            c->layout(device);
+        }
+        subtreeDirty = false;
+    }
+
+    // Device class changed: every node recomputes (or hits the per-device cache)
+    void invalidateAll() {
+        dirty = true;
+        subtreeDirty = true;
+        for (auto& c : children) {
+            c->invalidateAll();
+        }
+    }
+
+    virtual void render() {
+        for (auto& c : children) {
+            c->render();
+        }
+    }
+
+    void attachShadow(ShadowRegistry& registry) {
+        shadowRegistry = &registry;
+        shadowId = registry.registerShadow(layoutRect);
+        invalidate();  // Shadow bounds follow the next layout
+    }
+};
+
+uint32_t LayoutNode::nextNodeId = 1;
+size_t LayoutNode::measuredCount = 0;
+
+class Panel : public LayoutNode {
+protected:
+    Rect measure(DeviceClass device) override {
+        Rect r = rect;
+        if (device == DeviceClass::Phone) {
+            r.size.x *= 0.95f;
+            r.size.y *= 0.95f;
+        }
+        return r;
+    }
+
+public:
+    void render() override {
+        std::cout << "Render Panel at "
+                  << layoutRect.position.x << ", "
+                  << layoutRect.position.y << "\n";
+        LayoutNode::render();
+    }
+};
+
+class Dock : public LayoutNode {
+protected:
+    Rect measure(DeviceClass device) override {
+        Rect r = rect;
+        if (device == DeviceClass::Desktop) {
+            r.size.y = 80.0f;
+        } else {
+            r.size.y = 64.0f;
+        }
+        return r;
+    }
+
+public:
+    void render() override {
+        std::cout << "Render Dock\n";
+        LayoutNode::render();
+    }
+};
+
+class Window : public LayoutNode {
+protected:
+    Rect measure(DeviceClass device) override {
+        Rect r = rect;
+        if (device == DeviceClass::Phone) {
+            r.position = {0, 0};
+        }
+        return r;
+    }
+
+public:
+    void render() override {
+        std::cout << "Render Window\n";
+        LayoutNode::render();
+    }
+};
+
+class LayoutTree {
+    std::shared_ptr<LayoutNode> root;
+    DeviceClass lastDevice = DeviceClass::Desktop;
+    bool laidOut = false;
+
+public:
+    LayoutTree() {
+        root = std::make_shared<Panel>();
+    }
+
+    std::shared_ptr<LayoutNode> getRoot() {
+        return root;
+    }
+
+    // Steady state (nothing dirty, same device) returns before touching any node
+    void layout(DeviceClass device) {
+        if (laidOut && device != lastDevice) {
+            root->invalidateAll();
+        }
+        lastDevice = device;
+        laidOut = true;
+        if (!root->needsLayout()) return;
+
+        root->layout(device);
+        adaptive::cacheLayout();
+    }
+
+    void render() {
+        root->render();
+    }
+};
+
+// What screens see of the engine on enter/exit
+class Context {
+public:
+    DeviceClass device;
+    LayoutTree& layout;
+    proto::RenderQueue& commands;
+};
+
+class UHSUIEngine {
+    DeviceClass device;
+    LayoutTree layoutTree;
+    ShadowRegistry shadowRegistry;
+    SunlightState sunlight;
+    proto::RenderQueue renderQueue;     // App/UI threads submit through CommandWriters
+    proto::CommandSink discard;         // No framebuffer yet: consumed, not drawn
+    ScreenRegistry screens;
+    Router router;
+    Context context;
+    std::mutex navMutex;
+    std::deque<std::string> navRequests;   // Empty name = back
+    bool running = false;
+
+    // Back navigation presents the left screen's last frame straight from
+    // the framebuffer copy the router took on the way out
+    void installRouterHooks() {
+        RouterHooks hooks;
+        hooks.capture = [](CachedFrame& f) {
+            uint32_t* src = framebuffer::pixels();
+            int w = framebuffer::getWidth(), h = framebuffer::getHeight(), stride = framebuffer::getStride();
+            if (!src || w <= 0 || h <= 0) return false;
+            f.width = w;
+            f.height = h;
+            f.pixels.resize(static_cast<size_t>(w) * h);
+            for (int y = 0; y < h; y++) {
+                std::memcpy(&f.pixels[static_cast<size_t>(y) * w], src + static_cast<size_t>(y) * stride, w * sizeof(uint32_t));
+            }
+            return true;
+        };
+        hooks.present = [](const CachedFrame& f) {
+            uint32_t* dst = framebuffer::pixels();
+            int stride = framebuffer::getStride();
+            if (!dst || f.width != framebuffer::getWidth() || f.height != framebuffer::getHeight()) return;
+            for (int y = 0; y < f.height; y++) {
+                std::memcpy(dst + static_cast<size_t>(y) * stride, &f.pixels[static_cast<size_t>(y) * f.width], f.width * sizeof(uint32_t));
+            }
+            framebuffer::markDirty();
+        };
+        router.setHooks(std::move(hooks));
+    }
+
+public:
+    UHSUIEngine(DeviceClass d) : device(d), router(screens), context{d, layoutTree, renderQueue} {}
+
+    proto::RenderQueue& commands() {
+        return renderQueue;
+    }
+
+    // Screens register before run(); the registry takes ownership
+    ScreenId addScreen(Screen* screen) {
+        return screens.registerScreen(screen);
+    }
+
+    // Any thread. The router is engine-thread only, so requests are applied
+    // at the start of the next frame; a cached frame of the target is
+    // presented at once, and that frame renders it live.
+    void navigate(const std::string& name) {
+        {
+            std::lock_guard<std::mutex> lock(navMutex);
+            navRequests.push_back(name);
+        }
+        pacing::framePacer().invalidate(pacing::FrameState);
+    }
+
+    void back() {
+        navigate(std::string());
+    }
+
+    void applyNavigation() {
+        std::deque<std::string> requests;
+        {
+            std::lock_guard<std::mutex> lock(navMutex);
+            requests.swap(navRequests);
+        }
+        for (const auto& name : requests) {
+            bool ok = name.empty() ? router.back(context) : router.navigate(name, context);
+            if (!ok) std::cout << "Navigation to '" << name << "' failed\n";
+        }
+    }
+
+    void buildDefaultLayout() {
+        auto root = layoutTree.getRoot();
+        root->setRect({{0, 0}, {1280, 720}});
+
+        auto window = std::make_shared<Window>();
+        window->setRect({{100, 100}, {800, 500}});
+
+        auto dock = std::make_shared<Dock>();
+        dock->setRect({{0, 640}, {1280, 80}});
+
+        window->attachShadow(shadowRegistry);
+        dock->attachShadow(shadowRegistry);
+
+        root->addChild(window);
+        root->addChild(dock);
+    }
+
+    void update(float time) {
+        sunlight.update(time);
+    }
+
+    void renderFrame() {
+        std::cout << "Sun angle: " << sunlight.angle
+                  << " intensity: " << sunlight.intensity << "\n";
+
+        layoutTree.render();
+
+        // Buffers submitted since the last frame run here, on the render thread,
+        // into the GPU backend once it is up and the software renderer until then
+        proto::CommandSink* sink = gpu::activeBackend();
+        if (!sink) sink = &discard;
+        renderQueue.drain(*sink);
+        sink->endFrame();
+
+        for (const auto& s : shadowRegistry.getShadows()) {
+            std::cout << "Shadow ID " << s.id << " at "
+                      << s.projected.position.x << ", "
+                      << s.projected.position.y << " mask "
+                      << s.maskW << "x" << s.maskH << "\n";
+        }
+    }
+
+    void run() {
+        running = true;
+        framebuffer::configure(1280, 720);
+        touch::setTimeSource(pacing::now);  // Release times on the pacer's clock
+        installRouterHooks();
+        gesture_engine_init();
+        buildDefaultLayout();
+
+        // Frames are rendered on invalidation only; the sun moves 6 deg/s, so
+        // it asks for a frame per visible 0.5 deg step instead of every vsync
+        pacing::FramePacer& pacer = pacing::framePacer();
+        const uint64_t sunStepNs = 83000000;
+        pacer.invalidate(pacing::FrameState);
+
+        // Clients are optional: without a runtime dir the engine runs alone
+        // (dispatch/presented do nothing then)
+        wayland::Compositor& clients = wayland::compositor();
+        if (clients.start(wayland::CompositorConfig{})) {
+            std::cout << "Wayland: serving " << clients.socketName() << "\n";
+        }
+
+        while (running) {
+            pacer.waitForFrame();
+            uint64_t frameTime = pacing::now();
+            clients.dispatch();     // Commits queued so far make this frame
+            gesture_engine_tick(pacing::now());
+            applyNavigation();
+            float time = Clock::timeSeconds();
+            update(time);
+            layoutTree.layout(device);
+            shadowRegistry.refresh(sunlight);
+            renderFrame();
+            pacer.frameDone();
+            uint64_t presentTime = pacing::now();
+            clients.presented(presentTime);
+            touch::reportPresent(frameTime, presentTime);   // Latency the touch predictor covers
+            router.frameRendered();
+
+            // Nothing queued for the next frame: prepare likely next screens meanwhile
+            if (!pacer.pending()) router.idle(context);
+
+            // A pending long press needs a frame at its deadline even if nothing else moves
+            if (uint64_t due = gesture_engine_next_deadline()) pacer.scheduleAt(due, pacing::FrameInput);
+
+            if (time > 1.0f) {
+                running = false;
+            } else {
+                pacer.scheduleAt(pacing::now() + sunStepNs, pacing::FrameAnimation);
+            }
+        }
+
+        clients.stop();
+
+        const ShadowStats& shadows = shadowRegistry.getStats();
+        std::cout << "Shadows: " << shadows.projections << " projections, " << shadows.maskPixels
+                  << " of " << shadows.fullPassPixels << " mask pixels a per-frame pass would rasterize\n";
+
+        const pacing::PacerStats& frames = pacer.stats();
+        std::cout << "Frames: " << frames.frames << " rendered, " << frames.missed << " missed, "
+                  << frames.wakeups << " wakeups\n";
+        const RouterStats& nav = router.stats();
+        std::cout << "Navigation: " << nav.navigations << " navigations, " << nav.prewarmHits
+                  << " prewarmed, " << nav.cacheHits << " from cache\n";
+        auto cache = adaptive::stats();
+        std::cout << "Layout: " << LayoutNode::measuredCount << " nodes measured, "
+                  << cache.hits << " cache hits\n";
+    }
+};
+
+int main() {
+    UHSUIEngine engine(DeviceClass::Desktop);
+    engine.run();
+    return 0;
+}
\ No newline at end of file
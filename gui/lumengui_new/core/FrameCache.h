@@ -0,0 +1,57 @@
+#pragma once
+#include <stdint.h>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+// Snapshot of a screen's last presented frame (ARGB8888, tightly packed)
+struct CachedFrame {
+    std::vector<uint32_t> pixels;
+    int width = 0;
+    int height = 0;
+};
+
+// Keeps the last frame of the most recently left screens, so back navigation
+// can present something before the live screen renders. Bounded LRU.
+template <typename Key>
+class FrameCache {
+    struct Entry {
+        Key key;
+        CachedFrame frame;
+    };
+    std::list<Entry> entries;   // Front = most recent
+    std::unordered_map<Key, typename std::list<Entry>::iterator> index;
+    size_t capacity;
+public:
+    explicit FrameCache(size_t cap = 4) : capacity(cap) {}
+
+    // Slot to fill for key; recycles the evicted frame's memory
+    CachedFrame& slot(Key key) {
+        auto it = index.find(key);
+        if (it != index.end()) {
+            entries.splice(entries.begin(), entries, it->second);
+            return it->second->frame;
+        }
+        if (entries.size() >= capacity && !entries.empty()) {
+            entries.splice(entries.begin(), entries, std::prev(entries.end()));
+            index.erase(entries.front().key);
+            entries.front().key = key;
+        } else {
+            entries.push_front(Entry{key, CachedFrame{}});
+        }
+        index[key] = entries.begin();
+        return entries.front().frame;
+    }
+
+    const CachedFrame* find(Key key) const {
+        auto it = index.find(key);
+        return it == index.end() || it->second->frame.pixels.empty() ? nullptr : &it->second->frame;
+    }
+
+    void erase(Key key) {
+        auto it = index.find(key);
+        if (it == index.end()) return;
+        entries.erase(it->second);
+        index.erase(it);
+    }
+};
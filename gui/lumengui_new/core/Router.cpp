@@ -0,0 +1,193 @@
+#include "Router.h"
+#include <algorithm>
+#include <chrono>
+
+static uint64_t routerNowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// The worker starts last: it uses the mutex and queue declared after it
+Router::Router(ScreenRegistry& r) : registry(r) {
+    worker = std::thread([this] { run(); });
+}
+
+Router::~Router() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work.notify_all();
+    worker.join();
+}
+
+// Slots are created lazily (UI thread only) so screens may register late
+Router::Slot& Router::slot(ScreenId id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    while (slots.size() <= id) slots.emplace_back();
+    return slots[id];
+}
+
+void Router::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        work.wait(lock, [this] { return stopping || !queue.empty(); });
+        if (stopping) return;
+        auto [id, screen] = queue.front();
+        queue.pop_front();
+        Slot& s = slots[id];
+        uint8_t expected = Queued;
+        if (!s.warmth.compare_exchange_strong(expected, Preparing)) continue;  // Claimed inline
+
+        // The registry is UI-thread only; the screen was looked up by prewarm()
+        lock.unlock();
+        screen->prepare();
+        lock.lock();
+        s.warmth.store(Prepared, std::memory_order_release);
+        prepared.notify_all();
+    }
+}
+
+void Router::prewarm(ScreenId id) {
+    Screen* screen = registry.get(id);
+    if (!screen) return;
+    Slot& s = slot(id);
+    uint8_t expected = Cold;
+    if (!s.warmth.compare_exchange_strong(expected, Queued)) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.emplace_back(id, screen);
+    }
+    work.notify_one();
+}
+
+// Cold or still queued: prepare inline. Being prepared: wait for the worker.
+void Router::ensurePrepared(ScreenId id) {
+    Slot& s = slot(id);
+    uint8_t state = s.warmth.load(std::memory_order_acquire);
+    while (state == Cold || state == Queued) {
+        if (s.warmth.compare_exchange_weak(state, Preparing)) {
+            registry.get(id)->prepare();
+            std::lock_guard<std::mutex> lock(mutex);
+            s.warmth.store(Prepared, std::memory_order_release);
+            prepared.notify_all();
+            return;
+        }
+    }
+    if (state == Preparing) {
+        std::unique_lock<std::mutex> lock(mutex);
+        prepared.wait(lock, [&] { return s.warmth.load(std::memory_order_acquire) == Prepared; });
+    }
+}
+
+// Prepared screens other than the current one, the back target and keep give
+// their resources back. Only the UI thread grows slots, and only Prepared
+// slots are released, so the worker is never inside prepare() of one of them.
+void Router::releaseUnlikely(const std::vector<ScreenId>& keep) {
+    ScreenId back = history.empty() ? kNoScreen : history.back();
+    for (ScreenId id = 0; id < slots.size(); id++) {
+        if (id == currentId || id == back || std::find(keep.begin(), keep.end(), id) != keep.end()) continue;
+        Slot& s = slots[id];
+        uint8_t expected = Prepared;
+        if (!s.warmth.compare_exchange_strong(expected, Cold)) continue;
+        s.offscreenTried = false;
+        registry.get(id)->release();
+    }
+}
+
+void Router::learn(ScreenId from, ScreenId to, uint32_t weight) {
+    auto& next = slot(from).next;
+    auto it = std::find_if(next.begin(), next.end(), [to](const auto& p) { return p.first == to; });
+    if (it == next.end()) next.emplace_back(to, weight);
+    else it->second += weight;
+    std::sort(next.begin(), next.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+}
+
+void Router::hintNext(ScreenId from, ScreenId to) {
+    learn(from, to, 1000);
+}
+
+void Router::recordFirstFrame(uint64_t now) {
+    uint64_t latency = now - navigateNs;
+    stats_.firstFrames++;
+    stats_.lastFirstFrameNs = latency;
+    stats_.sumFirstFrameNs += latency;
+    stats_.maxFirstFrameNs = std::max(stats_.maxFirstFrameNs, latency);
+    awaitingFrame = false;
+}
+
+bool Router::enter(ScreenId id, Context& ctx, bool pushHistory) {
+    Screen* target = registry.get(id);
+    if (!target) return false;
+    navigateNs = routerNowNs();
+    stats_.navigations++;
+
+    if (current) {
+        if (hooks.capture) {
+            CachedFrame& f = frames.slot(currentId);
+            if (!hooks.capture(f)) frames.erase(currentId);
+        }
+        current->onExit(ctx);
+        learn(currentId, id, 1);
+        if (pushHistory) history.push_back(currentId);
+    }
+
+    if (slot(id).warmth.load(std::memory_order_acquire) == Prepared) stats_.prewarmHits++;
+    ensurePrepared(id);
+    current = target;
+    currentId = id;
+    current->onEnter(ctx);
+
+    const CachedFrame* cached = frames.find(id);
+    awaitingFrame = true;
+    if (cached && hooks.present) {
+        hooks.present(*cached);
+        stats_.cacheHits++;
+        recordFirstFrame(routerNowNs());
+    }
+    return true;
+}
+
+bool Router::navigate(ScreenId id, Context& ctx) {
+    return enter(id, ctx, true);
+}
+
+bool Router::back(Context& ctx) {
+    if (history.empty()) return false;
+    ScreenId id = history.back();
+    history.pop_back();
+    return enter(id, ctx, false);
+}
+
+void Router::frameRendered() {
+    if (awaitingFrame) recordFirstFrame(routerNowNs());
+}
+
+// Prewarms the two most likely next screens, then renders at most one
+// prepared candidate offscreen so its first frame is ready in the cache.
+// The render is bracketed by onEnter/onExit like a real visit, so render()
+// never sees a screen whose enter-time state was not set up.
+void Router::idle(Context& ctx) {
+    if (currentId == kNoScreen) return;
+    std::vector<ScreenId> likely;
+    for (const auto& p : slot(currentId).next) {
+        if (likely.size() == 2) break;
+        likely.push_back(p.first);
+    }
+    releaseUnlikely(likely);
+    for (ScreenId id : likely) prewarm(id);
+
+    if (!hooks.renderOffscreen) return;
+    for (ScreenId id : likely) {
+        Slot& s = slot(id);
+        if (s.offscreenTried || frames.find(id) || s.warmth.load(std::memory_order_acquire) != Prepared) continue;
+        s.offscreenTried = true;
+        Screen& screen = *registry.get(id);
+        CachedFrame& f = frames.slot(id);
+        screen.onEnter(ctx);
+        bool rendered = hooks.renderOffscreen(screen, ctx, f);
+        screen.onExit(ctx);
+        if (!rendered) frames.erase(id);
+        break;
+    }
+}
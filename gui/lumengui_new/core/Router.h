@@ -0,0 +1,91 @@
+#pragma once
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "FrameCache.h"
+#include "ScreenRegistry.h"
+
+class Context;
+
+struct RouterStats {
+    uint64_t navigations;
+    uint64_t prewarmHits;       // Target was already prepared
+    uint64_t cacheHits;         // A cached frame was presented immediately
+    uint64_t firstFrames;
+    uint64_t lastFirstFrameNs;  // navigate() -> first frame on screen
+    uint64_t sumFirstFrameNs;
+    uint64_t maxFirstFrameNs;
+};
+
+// Engine-side callbacks; any may be left empty
+struct RouterHooks {
+    std::function<bool(CachedFrame&)> capture;                          // Copy the frame on screen
+    std::function<void(const CachedFrame&)> present;                    // Show a cached frame now
+    std::function<bool(Screen&, Context&, CachedFrame&)> renderOffscreen;  // Between onEnter/onExit
+};
+
+// Navigation between interned screens. Likely next screens (learned from
+// past transitions, or hinted) are prepared on a background thread and get
+// an offscreen first frame during idle time; the last frame of every left
+// screen is cached so back navigation presents instantly.
+class Router {
+public:
+    explicit Router(ScreenRegistry& r);
+    ~Router();
+
+    void setHooks(RouterHooks h) { hooks = std::move(h); }
+
+    bool navigate(ScreenId id, Context& ctx);
+    bool navigate(const std::string& name, Context& ctx) { return navigate(registry.find(name), ctx); }
+    bool back(Context& ctx);
+
+    void hintNext(ScreenId from, ScreenId to);
+    void prewarm(ScreenId id);
+    void idle(Context& ctx);
+
+    // Engine reports each presented frame; closes the latency measurement
+    void frameRendered();
+
+    Screen* active() { return current; }
+    ScreenId activeId() const { return currentId; }
+    const RouterStats& stats() const { return stats_; }
+
+private:
+    enum Warmth : uint8_t { Cold, Queued, Preparing, Prepared };
+    struct Slot {
+        std::atomic<uint8_t> warmth{Cold};
+        std::vector<std::pair<ScreenId, uint32_t>> next;   // Transition counts
+        bool offscreenTried = false;
+    };
+
+    ScreenRegistry& registry;
+    Screen* current = nullptr;
+    ScreenId currentId = kNoScreen;
+    std::deque<Slot> slots;     // Stable addresses as screens are added
+    std::vector<ScreenId> history;
+    FrameCache<ScreenId> frames;
+    RouterHooks hooks;
+    RouterStats stats_{};
+    uint64_t navigateNs = 0;
+    bool awaitingFrame = false;
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable work, prepared;
+    std::deque<std::pair<ScreenId, Screen*>> queue;    // Resolved on the UI thread
+    bool stopping = false;
+
+    Slot& slot(ScreenId id);
+    void ensurePrepared(ScreenId id);
+    void releaseUnlikely(const std::vector<ScreenId>& keep);
+    void learn(ScreenId from, ScreenId to, uint32_t weight);
+    void recordFirstFrame(uint64_t now);
+    bool enter(ScreenId id, Context& ctx, bool pushHistory);
+    void run();
+};
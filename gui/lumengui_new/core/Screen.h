@@ -0,0 +1,23 @@
+#pragma once
+#include <string>
+
+class Context;
+class Renderer;
+
+class Screen {
+public:
+    virtual std::string id() const = 0;
+
+    // Heavy, UI-independent setup (assets, data, lists). Runs on the router's
+    // prewarm thread ahead of navigation, or inline on a cold navigate; must
+    // not touch UI state. Called at most once until release().
+    virtual void prepare() {}
+    virtual void release() {}
+
+    // Also bracket the router's offscreen first frame of a likely next
+    // screen, so render() can always rely on onEnter having run
+    virtual void onEnter(Context&) {}
+    virtual void onExit(Context&) {}
+    virtual void render(Renderer&, Context&) = 0;
+    virtual ~Screen() {}
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Screen.h"
+
+// Interned screen identifier: dense index into the registry
+using ScreenId = uint32_t;
+constexpr ScreenId kNoScreen = UINT32_MAX;
+
+class ScreenRegistry {
+    std::unordered_map<std::string, ScreenId> ids;
+    std::vector<std::string> names;
+    std::vector<std::unique_ptr<Screen>> screens;
+public:
+    // Returns the id for a name, allocating one on first use
+    ScreenId intern(const std::string& name) {
+        auto it = ids.find(name);
+        if (it != ids.end()) return it->second;
+        ScreenId id = static_cast<ScreenId>(names.size());
+        ids.emplace(name, id);
+        names.push_back(name);
+        screens.emplace_back();
+        return id;
+    }
+
+    ScreenId find(const std::string& name) const {
+        auto it = ids.find(name);
+        return it == ids.end() ? kNoScreen : it->second;
+    }
+
+    ScreenId registerScreen(Screen* screen) {
+        ScreenId id = intern(screen->id());
+        screens[id] = std::unique_ptr<Screen>(screen);
+        return id;
+    }
+
+    Screen* get(ScreenId id) const {
+        return id < screens.size() ? screens[id].get() : nullptr;
+    }
+
+    Screen* get(const std::string& name) const {
+        return get(find(name));
+    }
+
+    const std::string& name(ScreenId id) const {
+        return names[id];
+    }
+
+    size_t size() const {
+        return screens.size();
+    }
+};
@@ -0,0 +1,32 @@
+#include "gui_handle.hpp"
+
+namespace palisade::gui::api {
+
+uint64_t allocateHandle() {
+    static uint64_t next = 1;
+    return next++;
+}
+
+Handle HandlePool::acquire() {
+    if (!freeSlots.empty()) {
+        uint32_t index = freeSlots.back();
+        freeSlots.pop_back();
+        return {index, generations[index]};
+    }
+    generations.push_back(1);
+    return {static_cast<uint32_t>(generations.size() - 1), 1};
+}
+
+void HandlePool::release(Handle h) {
+    if (!valid(h)) return;
+    // Skip 0 on wrap so a recycled slot never hands out the null generation
+    uint32_t next = generations[h.index] + 1;
+    generations[h.index] = next ? next : 1;
+    freeSlots.push_back(h.index);
+}
+
+bool HandlePool::valid(Handle h) const {
+    return h.generation != 0 && h.index < generations.size() && generations[h.index] == h.generation;
+}
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+
+namespace palisade::gui::api {
+
+// Generational handle: slot index + generation. A released slot bumps its
+// generation, so stale handles to a reused slot are detected instead of aliasing.
+struct Handle {
+    uint32_t index = 0;
+    uint32_t generation = 0;  // 0 = null handle
+
+    uint64_t pack() const { return (static_cast<uint64_t>(generation) << 32) | index; }
+    static Handle unpack(uint64_t v) { return {static_cast<uint32_t>(v), static_cast<uint32_t>(v >> 32)}; }
+    explicit operator bool() const { return generation != 0; }
+    bool operator==(const Handle& o) const { return index == o.index && generation == o.generation; }
+    bool operator!=(const Handle& o) const { return !(*this == o); }
+};
+
+class HandlePool {
+    std::vector<uint32_t> generations;
+    std::vector<uint32_t> freeSlots;
+
+public:
+    Handle acquire();
+    void release(Handle h);
+    bool valid(Handle h) const;
+    uint32_t capacity() const { return static_cast<uint32_t>(generations.size()); }
+};
+
+uint64_t allocateHandle();
+
+}
@@ -0,0 +1,101 @@
+#include "sensor_hub.hpp"
+#include "../../../../gui_mod/include/sensors.h"
+#include "../../../../gui_mod/include/gui_module.h"
+#include <atomic>
+#include <cmath>
+#include <mutex>
+
+namespace palisade::gui::platform::mobile {
+
+namespace {
+
+std::once_flag configured;
+std::atomic<void (*)(int, float)> watchers[kSensorCount];
+
+// Per-sensor rates: notifications (where the driver sends them) do the real
+// work, the period only bounds how stale a silent node can get
+void configureDefaults(SensorHub& hub) {
+    SensorConfig battery;
+    battery.path = "/sys/class/power_supply/battery/capacity";
+    battery.periodNs = 10000000000ULL;
+    hub.configure(SensorId::Battery, battery);
+
+    SensorConfig charger;
+    charger.path = "/sys/class/power_supply/usb/online";
+    charger.periodNs = 2000000000ULL;
+    hub.configure(SensorId::Charger, charger);
+
+    SensorConfig thermal;
+    thermal.path = "/sys/class/thermal/thermal_zone0/temp";
+    thermal.periodNs = 1000000000ULL;
+    thermal.scale = 0.001f;                 // Millidegrees
+    thermal.filter = FilterKind::Median;
+    thermal.window = 5;
+    thermal.deadband = 0.5f;
+    hub.configure(SensorId::Thermal, thermal);
+
+    SensorConfig light;
+    light.path = "/sys/bus/iio/devices/iio:device0/in_illuminance_input";
+    light.periodNs = 200000000ULL;
+    light.filter = FilterKind::Ema;
+    light.emaAlpha = 0.25f;
+    light.deadband = 2.0f;
+    hub.configure(SensorId::Light, light);
+}
+
+void forward(SensorId id, const SensorReading& r, void*) {
+    auto fn = watchers[static_cast<int>(id)].load(std::memory_order_acquire);
+    if (fn) fn(static_cast<int>(id), r.value);
+}
+
+SensorHub& startedHub() {
+    SensorHub& hub = sensorHub();
+    std::call_once(configured, [&hub] {
+        configureDefaults(hub);
+        for (int i = 0; i < kSensorCount; i++) hub.listen(static_cast<SensorId>(i), forward);
+    });
+    hub.start();
+    return hub;
+}
+
+}
+
+}
+
+using namespace palisade::gui::platform::mobile;
+
+extern "C" int sensor_hub_start(void) {
+    return startedHub().running() ? 0 : -1;
+}
+
+extern "C" void sensor_hub_stop(void) {
+    sensorHub().stop();
+}
+
+extern "C" int sensor_read(int id, struct sensor_reading* out) {
+    if (id < 0 || id >= kSensorCount || !out) return -1;
+    SensorReading r = sensorHub().read(static_cast<SensorId>(id));
+    if (!r.seq) return -1;
+    out->value = r.value;
+    out->raw = r.raw;
+    out->time_ns = r.timeNs;
+    out->seq = r.seq;
+    return 0;
+}
+
+extern "C" int sensor_hub_watch(int id, void (*fn)(int id, float value)) {
+    if (id < 0 || id >= kSensorCount) return -1;
+    watchers[id].store(fn, std::memory_order_release);
+    return 0;
+}
+
+// Snapshot reads: safe from any thread at any rate
+extern "C" int battery_percent(void) {
+    struct sensor_reading r;
+    return sensor_read(SENSOR_BATTERY, &r) == 0 ? static_cast<int>(std::lround(r.value)) : 100;
+}
+
+extern "C" int thermal_celsius(void) {
+    struct sensor_reading r;
+    return sensor_read(SENSOR_THERMAL, &r) == 0 ? static_cast<int>(std::lround(r.value)) : 0;
+}
@@ -0,0 +1,30 @@
+#include "sensor_hub.hpp"
+
+namespace palisade::gui::platform::mobile {
+
+// Odd seq = publish in progress. Single writer, so plain stores replace the
+// CAS loop a shared slot needs.
+void SnapshotCell::publish(float v, int64_t r, uint64_t t) {
+    uint32_t s = seq.load(std::memory_order_relaxed);
+    seq.store(s + 1, std::memory_order_relaxed);
+    value.store(v, std::memory_order_release);
+    raw.store(r, std::memory_order_release);
+    timeNs.store(t, std::memory_order_release);
+    published.store(published.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    seq.store(s + 2, std::memory_order_release);
+}
+
+SensorReading SnapshotCell::read() const {
+    SensorReading r;
+    for (;;) {
+        uint32_t s0 = seq.load(std::memory_order_acquire);
+        if (s0 & 1) continue;
+        r.value = value.load(std::memory_order_acquire);
+        r.raw = raw.load(std::memory_order_acquire);
+        r.timeNs = timeNs.load(std::memory_order_acquire);
+        r.seq = published.load(std::memory_order_acquire);
+        if (seq.load(std::memory_order_relaxed) == s0) return r;
+    }
+}
+
+}
@@ -0,0 +1,44 @@
+#include "sensor_hub.hpp"
+#include <algorithm>
+
+namespace palisade::gui::platform::mobile {
+
+void SensorFilter::configure(FilterKind k, int w, float a) {
+    kind = k;
+    window = static_cast<uint8_t>(std::clamp(w, 1, kMaxWindow));
+    alpha = std::clamp(a, 0.0f, 1.0f);
+    reset();
+}
+
+void SensorFilter::reset() {
+    head = 0;
+    count = 0;
+}
+
+float SensorFilter::push(float sample) {
+    ring[head] = sample;
+    head = static_cast<uint8_t>((head + 1) % window);
+    if (count < window) count++;
+
+    switch (kind) {
+    case FilterKind::Mean: {
+        float sum = 0.0f;
+        for (int i = 0; i < count; i++) sum += ring[i];
+        return sum / count;
+    }
+    case FilterKind::Median: {
+        // Spikes (a thermal zone reading 0 or 255 once) never reach the UI
+        float sorted[kMaxWindow];
+        std::copy(ring, ring + count, sorted);
+        std::nth_element(sorted, sorted + count / 2, sorted + count);
+        return sorted[count / 2];
+    }
+    case FilterKind::Ema:
+        ema = count == 1 ? sample : ema + alpha * (sample - ema);
+        return ema;
+    default:
+        return sample;
+    }
+}
+
+}
@@ -0,0 +1,223 @@
+#include "sensor_hub.hpp"
+#include "../../../timing/clock.hpp"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cmath>
+
+namespace palisade::gui::platform::mobile {
+
+namespace {
+
+constexpr uint64_t kReopenBackoffNs = 5000000000ULL;  // Missing node: retry this often at most
+
+bool parseValue(const char* text, int64_t& out) {
+    char* end;
+    errno = 0;
+    long long v = strtoll(text, &end, 10);
+    if (end == text || errno) return false;
+    out = v;
+    return true;
+}
+
+}
+
+SensorHub::SensorHub() = default;
+
+SensorHub::~SensorHub() {
+    stop();
+}
+
+void SensorHub::configure(SensorId id, const SensorConfig& cfg) {
+    if (running()) return;
+    Sensor& s = sensors[static_cast<int>(id)];
+    s.cfg = cfg;
+    s.filter.configure(cfg.filter, cfg.window, cfg.emaAlpha);
+    s.published = false;
+    s.notify = cfg.notify;
+    if (s.notify == NotifyKind::Auto) {
+        // sysfs attributes can't be inotify-watched; drivers that care call sysfs_notify()
+        s.notify = cfg.path && !strncmp(cfg.path, "/sys/", 5) ? NotifyKind::Poll : NotifyKind::Inotify;
+    }
+}
+
+void SensorHub::listen(SensorId id, SensorListener fn, void* user) {
+    Sensor& s = sensors[static_cast<int>(id)];
+    s.user.store(user, std::memory_order_relaxed);
+    s.listener.store(fn, std::memory_order_release);
+}
+
+bool SensorHub::start() {
+    if (running()) return true;
+    wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeFd < 0) return false;
+    inotifyFd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);  // Optional: periodic reads still work
+    stopping.store(false, std::memory_order_relaxed);
+    worker = std::thread([this] { run(); });
+    return true;
+}
+
+void SensorHub::stop() {
+    if (!running()) return;
+    stopping.store(true, std::memory_order_relaxed);
+    uint64_t one = 1;
+    (void)!::write(wakeFd, &one, sizeof(one));
+    worker.join();
+    for (Sensor& s : sensors) close(s);
+    ::close(wakeFd);
+    if (inotifyFd >= 0) ::close(inotifyFd);
+    wakeFd = inotifyFd = -1;
+}
+
+void SensorHub::requestSample(SensorId id) {
+    sensors[static_cast<int>(id)].forced.store(true, std::memory_order_relaxed);
+    if (wakeFd >= 0) {
+        uint64_t one = 1;
+        (void)!::write(wakeFd, &one, sizeof(one));
+    }
+}
+
+SensorHubStats SensorHub::stats() const {
+    return {reads.load(std::memory_order_relaxed), notifications.load(std::memory_order_relaxed),
+            publishes.load(std::memory_order_relaxed), openFailures.load(std::memory_order_relaxed)};
+}
+
+// Hub thread. The descriptor stays open; every read is a pread at offset 0.
+bool SensorHub::open(Sensor& s) {
+    s.fd = ::open(s.cfg.path, O_RDONLY | O_CLOEXEC | O_NONBLOCK);
+    if (s.fd < 0) {
+        openFailures.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (s.notify == NotifyKind::Inotify && inotifyFd >= 0)
+        s.watch = inotify_add_watch(inotifyFd, s.cfg.path, IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF);
+    return true;
+}
+
+void SensorHub::close(Sensor& s) {
+    if (s.watch >= 0 && inotifyFd >= 0) inotify_rm_watch(inotifyFd, s.watch);
+    if (s.fd >= 0) ::close(s.fd);
+    s.fd = s.watch = -1;
+}
+
+void SensorHub::sample(int index, uint64_t now) {
+    Sensor& s = sensors[index];
+    s.nextDue = now + s.cfg.periodNs;
+    if (s.fd < 0 && !open(s)) {
+        if (s.cfg.periodNs < kReopenBackoffNs) s.nextDue = now + kReopenBackoffNs;
+        return;
+    }
+
+    // For POLLPRI sysfs nodes this read also re-arms the notification
+    char buf[32];
+    ssize_t n = pread(s.fd, buf, sizeof(buf) - 1, 0);
+    reads.fetch_add(1, std::memory_order_relaxed);
+    if (n < 0) {
+        if (errno != EAGAIN && errno != EINTR) close(s);  // Node went away (driver unbound, replaced file)
+        return;
+    }
+    buf[n] = '\0';
+    int64_t raw;
+    if (!parseValue(buf, raw)) return;
+
+    float value = s.filter.push(static_cast<float>(raw) * s.cfg.scale);
+    if (s.published && (value == s.lastPublished || std::fabs(value - s.lastPublished) < s.cfg.deadband)) return;
+    s.published = true;
+    s.lastPublished = value;
+    cells[index].publish(value, raw, now);
+    publishes.fetch_add(1, std::memory_order_relaxed);
+
+    SensorListener fn = s.listener.load(std::memory_order_acquire);
+    if (fn) fn(static_cast<SensorId>(index), cells[index].read(), s.user.load(std::memory_order_relaxed));
+}
+
+void SensorHub::drainInotify(uint64_t now) {
+    alignas(struct inotify_event) char buf[1024];
+    ssize_t n;
+    while ((n = ::read(inotifyFd, buf, sizeof(buf))) > 0) {
+        for (char* p = buf; p < buf + n;) {
+            const auto* ev = reinterpret_cast<const struct inotify_event*>(p);
+            p += sizeof(struct inotify_event) + ev->len;
+            for (int i = 0; i < kSensorCount; i++) {
+                Sensor& s = sensors[i];
+                if (s.watch != ev->wd) continue;
+                struct stat st;
+                if (ev->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                    s.watch = -1;  // The kernel already dropped it
+                    close(s);
+                    s.nextDue = now;
+                } else if ((ev->mask & IN_ATTRIB) && fstat(s.fd, &st) == 0 && st.st_nlink == 0) {
+                    // Replaced by rename: our open fd keeps the old inode alive
+                    close(s);
+                    s.nextDue = now;
+                } else if (ev->mask & (IN_MODIFY | IN_CLOSE_WRITE)) {
+                    notifications.fetch_add(1, std::memory_order_relaxed);
+                    s.forced.store(true, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+}
+
+void SensorHub::run() {
+    struct pollfd fds[kSensorCount + 2];
+    int owner[kSensorCount + 2];
+
+    while (!stopping.load(std::memory_order_relaxed)) {
+        uint64_t now = time::now();
+        uint64_t next = UINT64_MAX;
+        for (int i = 0; i < kSensorCount; i++) {
+            Sensor& s = sensors[i];
+            if (!s.cfg.path) continue;
+            if (s.forced.exchange(false, std::memory_order_relaxed) || now >= s.nextDue) sample(i, now);
+            if (s.nextDue < next) next = s.nextDue;
+        }
+
+        int count = 0;
+        fds[count] = {wakeFd, POLLIN, 0};
+        owner[count++] = -1;
+        if (inotifyFd >= 0) {
+            fds[count] = {inotifyFd, POLLIN, 0};
+            owner[count++] = -2;
+        }
+        for (int i = 0; i < kSensorCount; i++) {
+            if (sensors[i].notify != NotifyKind::Poll || sensors[i].fd < 0) continue;
+            fds[count] = {sensors[i].fd, POLLPRI | POLLERR, 0};
+            owner[count++] = i;
+        }
+
+        int timeoutMs = -1;
+        if (next != UINT64_MAX) {
+            uint64_t wait = next > now ? next - now : 0;
+            timeoutMs = static_cast<int>((wait + 999999) / 1000000);
+        }
+        if (poll(fds, count, timeoutMs) <= 0) continue;
+
+        now = time::now();
+        for (int k = 0; k < count; k++) {
+            if (!fds[k].revents) continue;
+            if (owner[k] == -1) {
+                uint64_t v;
+                (void)!::read(wakeFd, &v, sizeof(v));
+            } else if (owner[k] == -2) {
+                drainInotify(now);
+            } else {
+                notifications.fetch_add(1, std::memory_order_relaxed);
+                sample(owner[k], now);
+            }
+        }
+    }
+}
+
+SensorHub& sensorHub() {
+    static SensorHub hub;
+    return hub;
+}
+
+}
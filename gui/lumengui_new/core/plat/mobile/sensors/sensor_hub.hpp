@@ -0,0 +1,128 @@
+#pragma once
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+
+namespace palisade::gui::platform::mobile {
+
+enum class SensorId : uint8_t { Battery, Charger, Thermal, Light, Count };
+constexpr int kSensorCount = static_cast<int>(SensorId::Count);
+
+enum class FilterKind : uint8_t { None, Mean, Median, Ema };
+
+// Poll = sysfs_notify (POLLPRI), Inotify = regular files, Auto picks by path.
+// Periodic reads continue either way; with notifications periodNs only
+// bounds staleness.
+enum class NotifyKind : uint8_t { None, Poll, Inotify, Auto };
+
+struct SensorConfig {
+    const char* path = nullptr;     // nullptr = sensor disabled
+    uint64_t periodNs = 1000000000ULL;
+    float scale = 1.0f;             // value = raw * scale
+    FilterKind filter = FilterKind::None;
+    uint8_t window = 1;             // Samples the filter sees (<= SensorFilter::kMaxWindow)
+    float emaAlpha = 0.3f;
+    float deadband = 0.0f;          // Smaller moves are not published
+    NotifyKind notify = NotifyKind::Auto;
+};
+
+struct SensorReading {
+    float value;                    // Filtered and scaled
+    int64_t raw;                    // Last raw sample
+    uint64_t timeNs;                // When value was published
+    uint32_t seq;                   // Bumps on every publish; 0 = never
+};
+
+// Fixed ring of recent samples; one instance per sensor, hub thread only
+class SensorFilter {
+public:
+    static constexpr int kMaxWindow = 16;
+
+    void configure(FilterKind kind, int window, float alpha);
+    void reset();
+    float push(float sample);
+
+private:
+    float ring[kMaxWindow] = {};
+    uint8_t head = 0, count = 0, window = 1;
+    FilterKind kind = FilterKind::None;
+    float alpha = 1.0f;
+    float ema = 0.0f;
+};
+
+// Seqlock over the latest reading: one writer (the hub), readers retry only
+// while a publish is mid-flight and never touch a file. Ordering as in the
+// state slots of gui_mod's event bus (state_write in gui_events.c).
+class SnapshotCell {
+public:
+    void publish(float value, int64_t raw, uint64_t timeNs);
+    SensorReading read() const;
+
+private:
+    alignas(64) std::atomic<uint32_t> seq{0};
+    std::atomic<uint32_t> published{0};
+    std::atomic<float> value{0.0f};
+    std::atomic<int64_t> raw{0};
+    std::atomic<uint64_t> timeNs{0};
+};
+
+using SensorListener = void (*)(SensorId id, const SensorReading& r, void* user);
+
+struct SensorHubStats {
+    uint64_t reads;                 // pread calls
+    uint64_t notifications;         // Reads triggered by poll/inotify
+    uint64_t publishes;
+    uint64_t openFailures;
+};
+
+// Owns one file descriptor per sensor for the life of the hub and samples on
+// a single thread: a poll() over the notifying fds, an inotify fd and a wake
+// eventfd, with the timeout set to the next periodic read that is due.
+class SensorHub {
+public:
+    SensorHub();
+    ~SensorHub();
+
+    void configure(SensorId id, const SensorConfig& cfg);  // Before start()
+    void listen(SensorId id, SensorListener fn, void* user = nullptr);  // Hub thread, after each publish
+    bool start();
+    void stop();
+    bool running() const { return worker.joinable(); }
+
+    SensorReading read(SensorId id) const { return cells[static_cast<int>(id)].read(); }
+    void requestSample(SensorId id);                       // Read now, e.g. after resume
+    SensorHubStats stats() const;
+
+private:
+    struct Sensor {
+        SensorConfig cfg;
+        NotifyKind notify = NotifyKind::None;
+        int fd = -1;
+        int watch = -1;
+        uint64_t nextDue = 0;
+        SensorFilter filter;
+        float lastPublished = 0.0f;
+        bool published = false;
+        std::atomic<SensorListener> listener{nullptr};
+        std::atomic<void*> user{nullptr};
+        std::atomic<bool> forced{false};
+    };
+
+    Sensor sensors[kSensorCount];
+    SnapshotCell cells[kSensorCount];
+    int wakeFd = -1;
+    int inotifyFd = -1;
+    std::atomic<bool> stopping{false};
+    std::thread worker;
+    std::atomic<uint64_t> reads{0}, notifications{0}, publishes{0}, openFailures{0};
+
+    void run();
+    bool open(Sensor& s);
+    void close(Sensor& s);
+    void sample(int index, uint64_t now);
+    void drainInotify(uint64_t now);
+};
+
+SensorHub& sensorHub();
+
+}
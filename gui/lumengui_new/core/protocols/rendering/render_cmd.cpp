@@ -0,0 +1,121 @@
+#include "render_cmd.hpp"
+#include "render_queue.hpp"
+#include <string.h>
+#include <chrono>
+#include <thread>
+
+namespace palisade::gui::protocol::render {
+
+uint64_t nowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static constexpr uint32_t align4(uint32_t v) {
+    return (v + 3u) & ~3u;
+}
+
+static int16_t clamp16(int v) {
+    return static_cast<int16_t>(v < -32768 ? -32768 : (v > 32767 ? 32767 : v));
+}
+
+static uint16_t clampU16(int v) {
+    return static_cast<uint16_t>(v < 0 ? 0 : (v > 65535 ? 65535 : v));
+}
+
+CommandWriter::CommandWriter(RenderQueue& q) : queue(q) {
+    for (auto& b : buffers) b = new CommandBuffer;
+    current = acquire();
+}
+
+CommandWriter::~CommandWriter() {
+    flush();
+    for (auto* b : buffers) {
+        while (b->inFlight.load(std::memory_order_acquire)) std::this_thread::yield();
+        delete b;
+    }
+}
+
+// Next buffer in the ring; waits for the render thread if all are in flight (backpressure)
+CommandBuffer* CommandWriter::acquire() {
+    CommandBuffer* b = buffers[nextBuffer];
+    nextBuffer = (nextBuffer + 1) % kBuffers;
+    while (b->inFlight.load(std::memory_order_acquire)) std::this_thread::yield();
+    b->used = 0;
+    b->count = 0;
+    return b;
+}
+
+void CommandWriter::flush() {
+    if (!current->count) return;
+    current->submitNs = nowNs();
+    current->inFlight.store(true, std::memory_order_relaxed);
+    queue.push(current);
+    current = acquire();
+}
+
+uint8_t* CommandWriter::reserve(Op op, uint32_t payload) {
+    uint32_t size = align4(sizeof(CmdHeader) + payload);
+    if (current->used + size > kCommandBufferBytes) flush();
+
+    uint8_t* p = current->data + current->used;
+    CmdHeader hdr{op, 0, static_cast<uint16_t>(size)};
+    memcpy(p, &hdr, sizeof(hdr));
+    current->used += size;
+    current->count++;
+    return p + sizeof(CmdHeader);
+}
+
+bool CommandWriter::rect(int x, int y, int w, int h, uint32_t color) {
+    if (w <= 0 || h <= 0) return false;
+    RectCmd c{clamp16(x), clamp16(y), clampU16(w), clampU16(h), color};
+    memcpy(reserve(Op::Rect, sizeof(c)), &c, sizeof(c));
+    return true;
+}
+
+bool CommandWriter::blit(uint32_t surface, int sx, int sy, int dx, int dy, int w, int h) {
+    if (w <= 0 || h <= 0) return false;
+    BlitCmd c{surface, clamp16(sx), clamp16(sy), clamp16(dx), clamp16(dy), clampU16(w), clampU16(h)};
+    memcpy(reserve(Op::Blit, sizeof(c)), &c, sizeof(c));
+    return true;
+}
+
+bool CommandWriter::text(int x, int y, uint32_t color, uint16_t font, const char* str, uint16_t length) {
+    if (!str || !length || length > kMaxTextBytes) return false;
+    TextCmd c{clamp16(x), clamp16(y), color, font, length};
+    uint8_t* p = reserve(Op::Text, sizeof(c) + length);
+    memcpy(p, &c, sizeof(c));
+    memcpy(p + sizeof(c), str, length);
+    return true;
+}
+
+bool CommandWriter::pushClip(int x, int y, int w, int h) {
+    ClipCmd c{clamp16(x), clamp16(y), clampU16(w), clampU16(h)};
+    memcpy(reserve(Op::PushClip, sizeof(c)), &c, sizeof(c));
+    return true;
+}
+
+bool CommandWriter::popClip() {
+    reserve(Op::PopClip, 0);
+    return true;
+}
+
+bool CommandWriter::setTransform(const float m[6]) {
+    TransformCmd c;
+    memcpy(c.m, m, sizeof(c.m));
+    memcpy(reserve(Op::SetTransform, sizeof(c)), &c, sizeof(c));
+    return true;
+}
+
+bool CommandWriter::layerBegin(uint16_t layer, uint8_t alpha) {
+    LayerCmd c{layer, alpha, 0};
+    memcpy(reserve(Op::LayerBegin, sizeof(c)), &c, sizeof(c));
+    return true;
+}
+
+bool CommandWriter::layerEnd() {
+    reserve(Op::LayerEnd, 0);
+    return true;
+}
+
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <stdint.h>
+#include <atomic>
+
+namespace palisade::gui::protocol::render {
+
+// Compact binary render commands. Every command is a 4-byte header followed by
+// a fixed payload (text carries its bytes inline); sizes are 4-byte aligned so
+// the render thread walks a buffer with one add per command.
+enum class Op : uint8_t {
+    Rect = 1,
+    Blit,
+    Text,
+    PushClip,
+    PopClip,
+    SetTransform,
+    LayerBegin,
+    LayerEnd,
+};
+
+struct CmdHeader {
+    Op op;
+    uint8_t flags;
+    uint16_t size;      // Header + payload, bytes
+};
+
+struct RectCmd {
+    int16_t x, y;
+    uint16_t w, h;
+    uint32_t color;     // ARGB8888
+};
+
+struct BlitCmd {
+    uint32_t surface;
+    int16_t sx, sy;
+    int16_t dx, dy;
+    uint16_t w, h;
+};
+
+struct TextCmd {
+    int16_t x, y;
+    uint32_t color;
+    uint16_t font;
+    uint16_t length;    // Bytes that follow (not NUL-terminated)
+};
+
+struct ClipCmd {
+    int16_t x, y;
+    uint16_t w, h;
+};
+
+struct TransformCmd {
+    float m[6];         // {a, b, c, d, tx, ty} as in Transform2D: x' = a*x + c*y + tx
+};
+
+struct LayerCmd {
+    uint16_t layer;
+    uint8_t alpha;
+    uint8_t reserved;
+};
+
+constexpr uint32_t kCommandBufferBytes = 16 * 1024;
+constexpr uint16_t kMaxTextBytes = 1024;
+
+// One submission unit. Owned by a CommandWriter, lent to the render thread while
+// inFlight is set; the intrusive next pointer links it into the MPSC queue.
+struct CommandBuffer {
+    std::atomic<CommandBuffer*> next{nullptr};
+    std::atomic<bool> inFlight{false};
+    uint64_t submitNs = 0;
+    uint32_t used = 0;
+    uint32_t count = 0;
+    alignas(8) uint8_t data[kCommandBufferBytes];
+};
+
+class RenderQueue;
+
+// Per-thread command encoder (not thread-safe: one per app/UI thread)
+class CommandWriter {
+public:
+    static constexpr int kBuffers = 4;
+
+    explicit CommandWriter(RenderQueue& queue);
+    ~CommandWriter();
+
+    bool rect(int x, int y, int w, int h, uint32_t color);
+    bool blit(uint32_t surface, int sx, int sy, int dx, int dy, int w, int h);
+    bool text(int x, int y, uint32_t color, uint16_t font, const char* str, uint16_t length);
+    bool pushClip(int x, int y, int w, int h);
+    bool popClip();
+    bool setTransform(const float m[6]);
+    bool layerBegin(uint16_t layer, uint8_t alpha);
+    bool layerEnd();
+
+    void flush();  // Submit the current buffer (no-op when empty)
+
+private:
+    RenderQueue& queue;
+    CommandBuffer* buffers[kBuffers];
+    CommandBuffer* current;
+    int nextBuffer = 0;
+
+    uint8_t* reserve(Op op, uint32_t payload);
+    CommandBuffer* acquire();
+};
+
+uint64_t nowNs();
+
+}
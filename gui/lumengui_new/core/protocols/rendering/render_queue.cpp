@@ -0,0 +1,196 @@
+#include "render_queue.hpp"
+#include <string.h>
+#include <thread>
+#include <vector>
+
+namespace palisade::gui::protocol::render {
+
+RenderQueue::RenderQueue() : head(&stub), tail(&stub) {}
+
+void RenderQueue::push(CommandBuffer* b) {
+    submitted.fetch_add(1, std::memory_order_relaxed);
+    link(b);
+}
+
+void RenderQueue::link(CommandBuffer* b) {
+    b->next.store(nullptr, std::memory_order_relaxed);
+    CommandBuffer* prev = head.exchange(b, std::memory_order_acq_rel);
+    prev->next.store(b, std::memory_order_release);
+}
+
+// Single consumer. Returns nullptr when empty or while a producer is mid-push.
+CommandBuffer* RenderQueue::pop() {
+    CommandBuffer* t = tail;
+    CommandBuffer* next = t->next.load(std::memory_order_acquire);
+    if (t == &stub) {
+        if (!next) return nullptr;
+        tail = next;
+        t = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+    if (next) {
+        tail = next;
+        return t;
+    }
+    if (t != head.load(std::memory_order_acquire)) return nullptr;
+
+    // t is the last node: re-insert the stub behind it so t can be detached
+    link(&stub);
+    next = t->next.load(std::memory_order_acquire);
+    if (next) {
+        tail = next;
+        return t;
+    }
+    return nullptr;
+}
+
+bool RenderQueue::empty() const {
+    return tail == &stub ? stub.next.load(std::memory_order_acquire) == nullptr
+                         : false;
+}
+
+// Completed first: it can only trail submitted, so equality means no push
+// (including one still linking in) was outstanding when it was read
+bool RenderQueue::idle() const {
+    uint64_t done = completed.load(std::memory_order_acquire);
+    return done == submitted.load(std::memory_order_acquire);
+}
+
+uint32_t RenderQueue::execute(const CommandBuffer& b, CommandSink& sink) {
+    const uint8_t* p = b.data;
+    const uint8_t* end = b.data + b.used;
+    uint32_t n = 0;
+
+    // Payloads are copied out: the buffer only guarantees 4-byte alignment
+    while (p < end) {
+        CmdHeader hdr;
+        memcpy(&hdr, p, sizeof(hdr));
+        if (hdr.size < sizeof(CmdHeader) || p + hdr.size > end) break;  // Corrupt buffer
+        const uint8_t* payload = p + sizeof(CmdHeader);
+
+        switch (hdr.op) {
+        case Op::Rect: {
+            RectCmd c;
+            memcpy(&c, payload, sizeof(c));
+            sink.rect(c);
+            break;
+        }
+        case Op::Blit: {
+            BlitCmd c;
+            memcpy(&c, payload, sizeof(c));
+            sink.blit(c);
+            break;
+        }
+        case Op::Text: {
+            TextCmd c;
+            memcpy(&c, payload, sizeof(c));
+            sink.text(c, reinterpret_cast<const char*>(payload + sizeof(c)));
+            break;
+        }
+        case Op::PushClip: {
+            ClipCmd c;
+            memcpy(&c, payload, sizeof(c));
+            sink.pushClip(c);
+            break;
+        }
+        case Op::PopClip:
+            sink.popClip();
+            break;
+        case Op::SetTransform: {
+            TransformCmd c;
+            memcpy(&c, payload, sizeof(c));
+            sink.setTransform(c);
+            break;
+        }
+        case Op::LayerBegin: {
+            LayerCmd c;
+            memcpy(&c, payload, sizeof(c));
+            sink.layerBegin(c);
+            break;
+        }
+        case Op::LayerEnd:
+            sink.layerEnd();
+            break;
+        }
+        p += hdr.size;
+        n++;
+    }
+    return n;
+}
+
+// Render thread: execute up to maxBuffers submissions in one batch
+uint32_t RenderQueue::drain(CommandSink& sink, uint32_t maxBuffers) {
+    uint32_t commands = 0;
+    for (uint32_t i = 0; i < maxBuffers; i++) {
+        CommandBuffer* b = pop();
+        if (!b) break;
+
+        uint64_t latency = nowNs() - b->submitNs;
+        stats_.buffers++;
+        stats_.latencySumNs += latency;
+        if (latency > stats_.latencyMaxNs) stats_.latencyMaxNs = latency;
+
+        commands += execute(*b, sink);
+        b->inFlight.store(false, std::memory_order_release);  // Back to its writer
+        completed.fetch_add(1, std::memory_order_release);
+    }
+    stats_.commands += commands;
+    return commands;
+}
+
+// Producers encode a UI-like mix (layer, clip, transform, rects, text) and
+// flush per "frame"; one render thread drains until everything arrived.
+QueueBenchResult benchmarkQueue(int producers, uint32_t commandsPerProducer) {
+    RenderQueue queue;
+    std::atomic<int> done{0};
+    const uint64_t expected = static_cast<uint64_t>(producers) * commandsPerProducer;
+
+    class CountingSink : public CommandSink {
+    public:
+        uint64_t checksum = 0;
+        void rect(const RectCmd& c) override { checksum += c.color; }
+        void text(const TextCmd& c, const char* bytes) override { checksum += c.length + bytes[0]; }
+    } sink;
+
+    uint64_t start = nowNs();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < producers; t++) {
+        threads.emplace_back([&queue, &done, commandsPerProducer, t] {
+            CommandWriter w(queue);
+            const float identity[6] = {1, 0, 0, 1, 0, 0};
+            uint32_t n = 0;
+            while (n < commandsPerProducer) {
+                uint32_t op = n % 16;
+                if (op == 0) w.layerBegin(static_cast<uint16_t>(t), 255);
+                else if (op == 1) w.pushClip(0, 0, 1440, 2560);
+                else if (op == 2) w.setTransform(identity);
+                else if (op == 13) w.text(10, static_cast<int>(n % 2000), 0xFFFFFFFF, 0, "Settings", 8);
+                else if (op == 14) w.popClip();
+                else if (op == 15) w.layerEnd();
+                else w.rect(static_cast<int>(n % 1400), static_cast<int>(n % 2500), 32, 32, 0xFF000000 | n);
+                if (++n % 256 == 0) w.flush();  // One UI frame worth of commands
+            }
+            w.flush();
+            done.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    uint64_t drained = 0;
+    while (drained < expected) {
+        uint32_t got = queue.drain(sink);
+        drained += got;
+        if (!got) std::this_thread::yield();
+    }
+    uint64_t elapsed = nowNs() - start;
+    for (auto& th : threads) th.join();  // Writers wait for their last buffers in ~CommandWriter
+
+    const QueueStats& st = queue.stats();
+    QueueBenchResult r;
+    r.commands = drained;
+    r.commandsPerSec = elapsed ? drained * 1e9 / elapsed : 0.0;
+    r.avgLatencyUs = st.buffers ? st.latencySumNs / 1e3 / st.buffers : 0.0;
+    r.maxLatencyUs = st.latencyMaxNs / 1e3;
+    return r;
+}
+
+}
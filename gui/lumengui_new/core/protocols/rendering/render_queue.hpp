@@ -0,0 +1,65 @@
+#pragma once
+#include "render_cmd.hpp"
+
+namespace palisade::gui::protocol::render {
+
+// Render-thread side of the protocol: one callback per decoded command
+class CommandSink {
+public:
+    virtual ~CommandSink() = default;
+    virtual void rect(const RectCmd&) {}
+    virtual void blit(const BlitCmd&) {}
+    virtual void text(const TextCmd&, const char* bytes) { (void)bytes; }
+    virtual void pushClip(const ClipCmd&) {}
+    virtual void popClip() {}
+    virtual void setTransform(const TransformCmd&) {}
+    virtual void layerBegin(const LayerCmd&) {}
+    virtual void layerEnd() {}
+    virtual void endFrame() {}  // After the frame's last drain
+};
+
+struct QueueStats {
+    uint64_t buffers;
+    uint64_t commands;
+    uint64_t latencySumNs;   // Submit -> decoded, per buffer
+    uint64_t latencyMaxNs;
+};
+
+// Vyukov intrusive MPSC queue: any thread may push (one atomic exchange),
+// only the render thread pops. Buffers go back to their writer by clearing
+// inFlight, so the steady state allocates nothing.
+class RenderQueue {
+public:
+    RenderQueue();
+
+    void push(CommandBuffer* b);
+    uint32_t drain(CommandSink& sink, uint32_t maxBuffers = 64);  // Returns commands executed
+    bool empty() const;  // Render thread only
+    bool idle() const;   // Any thread: everything pushed so far has been executed
+    const QueueStats& stats() const { return stats_; }
+
+private:
+    alignas(64) std::atomic<CommandBuffer*> head;
+    alignas(64) CommandBuffer* tail;
+    CommandBuffer stub;
+    QueueStats stats_{};
+    alignas(64) std::atomic<uint64_t> submitted{0};
+    alignas(64) std::atomic<uint64_t> completed{0};
+
+    void link(CommandBuffer* b);
+    CommandBuffer* pop();
+    uint32_t execute(const CommandBuffer& b, CommandSink& sink);
+};
+
+struct QueueBenchResult {
+    uint64_t commands;
+    double commandsPerSec;
+    double avgLatencyUs;
+    double maxLatencyUs;
+};
+
+QueueBenchResult benchmarkQueue(int producers, uint32_t commandsPerProducer);
+
+bool sync(const RenderQueue& queue);  // render_sync.cpp
+
+}
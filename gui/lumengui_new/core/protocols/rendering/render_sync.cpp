@@ -0,0 +1,11 @@
+#include "render_queue.hpp"
+
+namespace palisade::gui::protocol::render {
+
+// True once the render thread has executed every buffer submitted so far.
+// Safe from producers, unlike empty(), which also misses a push mid-link.
+bool sync(const RenderQueue& queue) {
+    return queue.idle();
+}
+
+}
@@ -0,0 +1,47 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace palisade::gui::render::framebuffer {
+
+static int width = 0;
+static int height = 0;
+static int stride = 0;
+static std::vector<uint32_t> backing;
+static uint32_t* memory = nullptr;
+
+// Allocates an owned ARGB8888 backbuffer
+void configure(int w, int h) {
+    width = w;
+    height = h;
+    stride = w;
+    backing.assign(static_cast<size_t>(w > 0 ? w : 0) * (h > 0 ? h : 0), 0xFF000000);
+    memory = backing.data();
+}
+
+// Renders into caller-owned memory (e.g. a mapped scanout buffer); stride in pixels
+void attach(uint32_t* pixels, int w, int h, int s) {
+    backing.clear();
+    width = w;
+    height = h;
+    stride = s;
+    memory = pixels;
+}
+
+int getWidth() {
+    return width;
+}
+
+int getHeight() {
+    return height;
+}
+
+int getStride() {
+    return stride;
+}
+
+uint32_t* pixels() {
+    return memory;
+}
+
+}
@@ -0,0 +1,25 @@
+#include "../software/sw_renderer.hpp"
+
+namespace palisade::gui::render::gpu {
+
+bool ready();
+
+static protocol::render::CommandSink* gpuBackend = nullptr;
+
+bool shouldFallback() {
+    return !ready();
+}
+
+// Called by a GPU backend once it can execute render commands
+void setBackend(protocol::render::CommandSink* sink) {
+    gpuBackend = sink;
+}
+
+// Sink the render thread drains into: the GPU backend when the context is up
+// and one registered, otherwise the tiled software renderer
+protocol::render::CommandSink* activeBackend() {
+    if (!shouldFallback() && gpuBackend) return gpuBackend;
+    return software::defaultRenderer();
+}
+
+}
@@ -0,0 +1,44 @@
+#include "sw_renderer.hpp"
+#include <string.h>
+
+namespace palisade::gui::render::software {
+
+// Blits are translated, not resampled: the transform moves the destination
+// origin, the source is copied 1:1 and clipped to the surface
+void SoftwareRenderer::blit(const proto::BlitCmd& c) {
+    auto it = surfaces.find(c.surface);
+    if (it == surfaces.end() || !alphas.back()) return;
+    const Surface& s = it->second;
+
+    Clip d = transformRect(c.dx, c.dy, 0, 0);
+    int sx = c.sx, sy = c.sy, w = c.w, h = c.h;
+    if (sx < 0) { d.x0 -= sx; w += sx; sx = 0; }
+    if (sy < 0) { d.y0 -= sy; h += sy; sy = 0; }
+    if (sx + w > s.width) w = s.width - sx;
+    if (sy + h > s.height) h = s.height - sy;
+    if (w <= 0 || h <= 0) return;
+
+    DrawOp op{};
+    op.kind = DrawOp::Blit;
+    op.surface = c.surface;
+    op.srcDX = sx - d.x0;
+    op.srcDY = sy - d.y0;
+    if (clipOp(op, {d.x0, d.y0, d.x0 + w, d.y0 + h})) bin(op);
+}
+
+// Per-pixel source alpha times layer alpha; opaque rows are plain copies
+void SoftwareRenderer::blitSpan(uint32_t* buf, const DrawOp& op, const Clip& area, int tileX, int tileY) {
+    const Surface& s = surfaces.at(op.surface);
+    int w = area.x1 - area.x0;
+    for (int y = area.y0; y < area.y1; y++) {
+        uint32_t* dst = buf + (y - tileY) * kTileSize + (area.x0 - tileX);
+        const uint32_t* src = s.pixels + static_cast<size_t>(y + op.srcDY) * s.stride + (area.x0 + op.srcDX);
+        for (int x = 0; x < w; x++) {
+            uint32_t a = ((src[x] >> 24) * op.alpha + 127) / 255;
+            if (a == 255) dst[x] = src[x];
+            else if (a) dst[x] = blendOver(dst[x], src[x], a);
+        }
+    }
+}
+
+}
@@ -0,0 +1,68 @@
+#include "sw_renderer.hpp"
+#include <string.h>
+#include <memory>
+
+namespace palisade::gui::render::framebuffer {
+void markDirty();
+uint32_t* pixels();
+int getWidth();
+int getHeight();
+int getStride();
+}
+
+namespace palisade::gui::render::software {
+
+void SoftwareRenderer::loadTile(uint32_t tile, uint32_t* buf, Clip& area) {
+    int tx = static_cast<int>(tile) % cols, ty = static_cast<int>(tile) / cols;
+    area = {tx * kTileSize, ty * kTileSize,
+            std::min(width, (tx + 1) * kTileSize), std::min(height, (ty + 1) * kTileSize)};
+    size_t bytes = static_cast<size_t>(area.x1 - area.x0) * sizeof(uint32_t);
+    for (int y = area.y0; y < area.y1; y++)
+        memcpy(buf + (y - area.y0) * kTileSize, fb + static_cast<size_t>(y) * stride + area.x0, bytes);
+}
+
+void SoftwareRenderer::storeTile(const uint32_t* buf, const Clip& area) {
+    size_t bytes = static_cast<size_t>(area.x1 - area.x0) * sizeof(uint32_t);
+    for (int y = area.y0; y < area.y1; y++)
+        memcpy(fb + static_cast<size_t>(y) * stride + area.x0, buf + (y - area.y0) * kTileSize, bytes);
+}
+
+// Rasterizes and flushes only the tiles that received commands this frame;
+// untouched tiles keep last frame's pixels
+void SoftwareRenderer::endFrame() {
+    uint64_t start = proto::nowNs();
+    pool.run(static_cast<uint32_t>(touched.size()), [this](uint32_t i, int worker) {
+        rasterTile(touched[i], scratch[worker].data());
+    });
+
+    stats.ops = static_cast<uint32_t>(ops.size());
+    stats.tilesTouched = static_cast<uint32_t>(touched.size());
+    stats.tilesTotal = static_cast<uint32_t>(bins.size());
+    stats.rasterNs = proto::nowNs() - start;
+
+    if (!touched.empty()) framebuffer::markDirty();
+    for (uint32_t tile : touched) bins[tile].clear();
+    touched.clear();
+    ops.clear();
+    textBytes.clear();
+}
+
+// Renderer over the configured framebuffer; recreated when it is reconfigured
+SoftwareRenderer* defaultRenderer() {
+    static std::unique_ptr<SoftwareRenderer> renderer;
+    static uint32_t* boundPixels = nullptr;
+    static int boundW = 0, boundH = 0;
+
+    uint32_t* px = framebuffer::pixels();
+    int w = framebuffer::getWidth(), h = framebuffer::getHeight();
+    if (!px || w <= 0 || h <= 0) return nullptr;
+    if (!renderer || px != boundPixels || w != boundW || h != boundH) {
+        renderer.reset(new SoftwareRenderer(px, w, h, framebuffer::getStride()));
+        boundPixels = px;
+        boundW = w;
+        boundH = h;
+    }
+    return renderer.get();
+}
+
+}
@@ -0,0 +1,298 @@
+#include "sw_renderer.hpp"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+
+namespace palisade::gui::render::software {
+
+TilePool::TilePool(int n) {
+    for (int i = 1; i < n; i++) threads.emplace_back([this, i] { work(i); });
+}
+
+TilePool::~TilePool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& t : threads) t.join();
+}
+
+// Next item of run gen. The counter carries its generation, so a worker can
+// never take an index that belongs to a later run.
+bool TilePool::claim(uint32_t gen, uint32_t n, uint32_t& item) {
+    uint64_t v = next.load(std::memory_order_relaxed);
+    for (;;) {
+        if (static_cast<uint32_t>(v >> 32) != gen || static_cast<uint32_t>(v) >= n) return false;
+        if (next.compare_exchange_weak(v, v + 1, std::memory_order_relaxed)) {
+            item = static_cast<uint32_t>(v);
+            return true;
+        }
+    }
+}
+
+void TilePool::work(int worker) {
+    uint32_t seen = 0;
+    for (;;) {
+        const std::function<void(uint32_t, int)>* fn;
+        uint32_t n, gen;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            if (!job) continue;     // Woke after that run already finished
+            fn = job;
+            n = count;
+            gen = generation;
+            busy++;
+        }
+        for (uint32_t i; claim(gen, n, i);) (*fn)(i, worker);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busy == 0) finished.notify_one();
+        }
+    }
+}
+
+// Items are claimed with one CAS each; returns once every item ran
+void TilePool::run(uint32_t n, const std::function<void(uint32_t, int)>& fn) {
+    if (!n) return;
+    if (threads.empty() || n == 1) {
+        for (uint32_t i = 0; i < n; i++) fn(i, 0);
+        return;
+    }
+    uint32_t gen;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        count = n;
+        gen = ++generation;
+        next.store(static_cast<uint64_t>(gen) << 32, std::memory_order_relaxed);
+    }
+    wake.notify_all();
+    for (uint32_t i; claim(gen, n, i);) fn(i, 0);
+
+    // Workers that woke late see an exhausted counter and leave immediately;
+    // ones that wake after this see no job
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&] { return busy == 0; });
+    job = nullptr;
+}
+
+static int defaultThreads() {
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw ? static_cast<int>(std::min(hw, 8u)) : 4;
+}
+
+SoftwareRenderer::SoftwareRenderer(uint32_t* framebuffer, int w, int h, int s, int threads)
+    : fb(framebuffer), width(w), height(h), stride(s),
+      cols((w + kTileSize - 1) / kTileSize), rows((h + kTileSize - 1) / kTileSize),
+      pool(threads > 0 ? threads : defaultThreads()) {
+    bins.resize(static_cast<size_t>(cols) * rows);
+    scratch.resize(pool.workers(), std::vector<uint32_t>(kTileSize * kTileSize));
+    clips.push_back({0, 0, width, height});
+    alphas.push_back(255);
+}
+
+void SoftwareRenderer::registerSurface(uint32_t id, const Surface& s) {
+    surfaces[id] = s;
+}
+
+// Axis-aligned bounds of a transformed rect; rotation and skew are conservative
+SoftwareRenderer::Clip SoftwareRenderer::transformRect(float x, float y, float w, float h) const {
+    const float* m = transform;
+    float xs[4] = {x, x + w, x, x + w};
+    float ys[4] = {y, y, y + h, y + h};
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (int i = 0; i < 4; i++) {
+        float tx = m[0] * xs[i] + m[2] * ys[i] + m[4];
+        float ty = m[1] * xs[i] + m[3] * ys[i] + m[5];
+        minX = std::min(minX, tx);
+        maxX = std::max(maxX, tx);
+        minY = std::min(minY, ty);
+        maxY = std::max(maxY, ty);
+    }
+    auto clampi = [](float v) { return static_cast<int>(std::max(-32768.0f, std::min(32767.0f, v))); };
+    return {clampi(floorf(minX + 0.5f)), clampi(floorf(minY + 0.5f)),
+            clampi(floorf(maxX + 0.5f)), clampi(floorf(maxY + 0.5f))};
+}
+
+// Intersects r with the current clip into op's bounds; false when nothing is left
+bool SoftwareRenderer::clipOp(DrawOp& op, const Clip& r) const {
+    const Clip& c = clips.back();
+    int x0 = std::max(r.x0, c.x0), y0 = std::max(r.y0, c.y0);
+    int x1 = std::min(r.x1, c.x1), y1 = std::min(r.y1, c.y1);
+    if (x0 >= x1 || y0 >= y1) return false;
+    op.x0 = static_cast<int16_t>(x0);
+    op.y0 = static_cast<int16_t>(y0);
+    op.x1 = static_cast<int16_t>(x1);
+    op.y1 = static_cast<int16_t>(y1);
+    op.alpha = alphas.back();
+    return true;
+}
+
+void SoftwareRenderer::bin(const DrawOp& op) {
+    uint32_t index = static_cast<uint32_t>(ops.size());
+    ops.push_back(op);
+    int tx0 = op.x0 / kTileSize, tx1 = (op.x1 - 1) / kTileSize;
+    int ty0 = op.y0 / kTileSize, ty1 = (op.y1 - 1) / kTileSize;
+    for (int ty = ty0; ty <= ty1; ty++) {
+        for (int tx = tx0; tx <= tx1; tx++) {
+            uint32_t tile = static_cast<uint32_t>(ty * cols + tx);
+            if (bins[tile].empty()) touched.push_back(tile);
+            bins[tile].push_back(index);
+        }
+    }
+}
+
+void SoftwareRenderer::rect(const proto::RectCmd& c) {
+    if (!(c.color >> 24) || !alphas.back()) return;
+    DrawOp op{};
+    op.kind = DrawOp::Fill;
+    op.color = c.color;
+    if (clipOp(op, transformRect(c.x, c.y, c.w, c.h))) bin(op);
+}
+
+// Placeholder glyph cells until a font rasterizer exists: one box per
+// non-space byte, sized from the font id (pixel height, 16 when unset)
+void SoftwareRenderer::text(const proto::TextCmd& c, const char* bytes) {
+    if (!(c.color >> 24) || !alphas.back()) return;
+    int size = c.font ? c.font : 16;
+    DrawOp op{};
+    op.kind = DrawOp::Glyphs;
+    op.color = c.color;
+    op.glyphW = static_cast<uint16_t>(std::max(2, size * 3 / 5));
+    op.glyphH = static_cast<uint16_t>(size);
+    Clip r = transformRect(c.x, c.y, 0, 0);
+    op.originX = r.x0;
+    op.originY = r.y0;
+    Clip bounds{r.x0, r.y0, r.x0 + op.glyphW * c.length, r.y0 + op.glyphH};
+    if (!clipOp(op, bounds)) return;
+    op.textOffset = static_cast<uint32_t>(textBytes.size());
+    op.textLength = c.length;
+    textBytes.insert(textBytes.end(), bytes, bytes + c.length);
+    bin(op);
+}
+
+void SoftwareRenderer::pushClip(const proto::ClipCmd& c) {
+    Clip r = transformRect(c.x, c.y, c.w, c.h);
+    const Clip& top = clips.back();
+    clips.push_back({std::max(r.x0, top.x0), std::max(r.y0, top.y0),
+                     std::min(r.x1, top.x1), std::min(r.y1, top.y1)});
+}
+
+void SoftwareRenderer::popClip() {
+    if (clips.size() > 1) clips.pop_back();
+}
+
+void SoftwareRenderer::setTransform(const proto::TransformCmd& c) {
+    memcpy(transform, c.m, sizeof(transform));
+}
+
+// Layers are flattened: their alpha multiplies into every op they contain
+void SoftwareRenderer::layerBegin(const proto::LayerCmd& c) {
+    alphas.push_back(static_cast<uint8_t>((alphas.back() * c.alpha + 127) / 255));
+}
+
+void SoftwareRenderer::layerEnd() {
+    if (alphas.size() > 1) alphas.pop_back();
+}
+
+void SoftwareRenderer::fillSpan(uint32_t* buf, const DrawOp& op, const Clip& area, int tileX, int tileY) {
+    uint32_t a = ((op.color >> 24) * op.alpha + 127) / 255;
+    int w = area.x1 - area.x0;
+    for (int y = area.y0; y < area.y1; y++) {
+        uint32_t* row = buf + (y - tileY) * kTileSize + (area.x0 - tileX);
+        if (a == 255) {
+            std::fill(row, row + w, op.color);
+        } else {
+            for (int x = 0; x < w; x++) row[x] = blendOver(row[x], op.color, a);
+        }
+    }
+}
+
+// Executes the tile's bin in submission order against a local copy of the tile
+void SoftwareRenderer::rasterTile(uint32_t tile, uint32_t* buf) {
+    Clip tileArea;
+    loadTile(tile, buf, tileArea);
+    for (uint32_t index : bins[tile]) {
+        const DrawOp& op = ops[index];
+        Clip area{std::max<int>(op.x0, tileArea.x0), std::max<int>(op.y0, tileArea.y0),
+                  std::min<int>(op.x1, tileArea.x1), std::min<int>(op.y1, tileArea.y1)};
+        if (area.x0 >= area.x1 || area.y0 >= area.y1) continue;
+
+        switch (op.kind) {
+        case DrawOp::Fill:
+            fillSpan(buf, op, area, tileArea.x0, tileArea.y0);
+            break;
+        case DrawOp::Blit:
+            blitSpan(buf, op, area, tileArea.x0, tileArea.y0);
+            break;
+        case DrawOp::Glyphs: {
+            const char* str = textBytes.data() + op.textOffset;
+            for (uint16_t i = 0; i < op.textLength; i++) {
+                if (str[i] == ' ') continue;
+                int gx = op.originX + i * op.glyphW;
+                Clip cell{std::max(area.x0, gx + 1), std::max(area.y0, op.originY + op.glyphH / 8),
+                          std::min(area.x1, gx + op.glyphW - 1), std::min(area.y1, op.originY + op.glyphH)};
+                if (cell.x0 < cell.x1 && cell.y0 < cell.y1) fillSpan(buf, op, cell, tileArea.x0, tileArea.y0);
+            }
+            break;
+        }
+        }
+    }
+    storeTile(buf, tileArea);
+}
+
+// Drains a settings-screen-like frame (background, rows, text) through the
+// queue, then a frame where only one toggle changes
+static void encodeFrame(proto::CommandWriter& w, int width, int height, bool partial, int frame) {
+    if (partial) {
+        w.rect(width - 120, 400, 80, 40, (frame & 1) ? 0xFF3478F6 : 0xFF8E8E93);
+        w.flush();
+        return;
+    }
+    const float identity[6] = {1, 0, 0, 1, 0, 0};
+    w.setTransform(identity);
+    w.rect(0, 0, width, height, 0xFFF2F2F7);
+    w.layerBegin(1, 230);
+    for (int y = 120; y + 80 < height; y += 96) {
+        w.rect(24, y, width - 48, 80, 0xFFFFFFFF);
+        w.text(48, y + 28, 0xFF000000, 24, "Display & Brightness", 20);
+        w.rect(width - 120, y + 20, 80, 40, 0xFF34C759);
+    }
+    w.layerEnd();
+    w.flush();
+}
+
+static double runFrames(SoftwareRenderer& r, proto::RenderQueue& q, proto::CommandWriter& w,
+                        int width, int height, bool partial, int frames) {
+    uint64_t start = proto::nowNs();
+    for (int f = 0; f < frames; f++) {
+        encodeFrame(w, width, height, partial, f);
+        q.drain(r);
+        r.endFrame();
+    }
+    return (proto::nowNs() - start) / 1e6 / (frames ? frames : 1);
+}
+
+SoftwareBenchResult benchmarkSoftware(int width, int height, int frames) {
+    std::vector<uint32_t> pixels(static_cast<size_t>(width) * height);
+    proto::RenderQueue queue;
+    SoftwareBenchResult res{};
+    {
+        proto::CommandWriter writer(queue);
+        SoftwareRenderer single(pixels.data(), width, height, width, 1);
+        res.singleThreadFullMs = runFrames(single, queue, writer, width, height, false, frames);
+    }
+    proto::CommandWriter writer(queue);
+    SoftwareRenderer r(pixels.data(), width, height, width);
+    res.fullFrameMs = runFrames(r, queue, writer, width, height, false, frames);
+    res.partialFrameMs = runFrames(r, queue, writer, width, height, true, frames);
+    res.partialTiles = r.lastFrame().tilesTouched;
+    res.tilesTotal = r.lastFrame().tilesTotal;
+    return res;
+}
+
+}
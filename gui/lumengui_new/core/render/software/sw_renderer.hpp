@@ -0,0 +1,144 @@
+#pragma once
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "../../protocols/rendering/render_queue.hpp"
+
+namespace palisade::gui::render::software {
+
+namespace proto = protocol::render;
+
+constexpr int kTileSize = 64;
+
+struct Surface {
+    const uint32_t* pixels;
+    int width;
+    int height;
+    int stride;         // In pixels
+};
+
+// A command resolved to screen space (transform, clip and layer alpha applied)
+struct DrawOp {
+    enum Kind : uint8_t { Fill, Blit, Glyphs };
+    Kind kind;
+    uint8_t alpha;              // Layer alpha
+    uint16_t glyphW, glyphH;
+    int16_t x0, y0, x1, y1;     // Clipped bounds, exclusive max
+    uint32_t color;
+    uint32_t surface;
+    int32_t srcDX, srcDY;       // Source pixel = screen pixel + srcD
+    int32_t originX, originY;   // Glyphs: pen position
+    uint32_t textOffset;
+    uint16_t textLength;
+};
+
+// Worker pool for tile rasterization; the calling thread works as worker 0
+class TilePool {
+public:
+    explicit TilePool(int threads);
+    ~TilePool();
+
+    int workers() const { return static_cast<int>(threads.size()) + 1; }
+    void run(uint32_t count, const std::function<void(uint32_t item, int worker)>& job);
+
+private:
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake, finished;
+    const std::function<void(uint32_t, int)>* job = nullptr;   // nullptr between runs
+    std::atomic<uint64_t> next{0};      // generation << 32 | next item
+    uint32_t count = 0;
+    int busy = 0;
+    uint32_t generation = 0;
+    bool stopping = false;
+
+    bool claim(uint32_t gen, uint32_t n, uint32_t& item);
+    void work(int worker);
+};
+
+// Executes render commands by binning them into 64x64 screen tiles during the
+// drain, then rasterizing only the touched tiles in parallel at endFrame().
+// Tiles are disjoint, so workers write the framebuffer without locking.
+class SoftwareRenderer : public proto::CommandSink {
+public:
+    struct FrameStats {
+        uint32_t ops;
+        uint32_t tilesTouched;
+        uint32_t tilesTotal;
+        uint64_t rasterNs;
+    };
+
+    SoftwareRenderer(uint32_t* framebuffer, int width, int height, int stride, int threads = 0);
+
+    void registerSurface(uint32_t id, const Surface& s);
+
+    void rect(const proto::RectCmd& c) override;
+    void blit(const proto::BlitCmd& c) override;
+    void text(const proto::TextCmd& c, const char* bytes) override;
+    void pushClip(const proto::ClipCmd& c) override;
+    void popClip() override;
+    void setTransform(const proto::TransformCmd& c) override;
+    void layerBegin(const proto::LayerCmd& c) override;
+    void layerEnd() override;
+
+    void endFrame() override;   // sw_flush.cpp
+    const FrameStats& lastFrame() const { return stats; }
+
+private:
+    struct Clip {
+        int x0, y0, x1, y1;
+    };
+
+    uint32_t* fb;
+    int width, height, stride;
+    int cols, rows;
+
+    float transform[6] = {1, 0, 0, 1, 0, 0};   // TransformCmd layout
+    std::vector<Clip> clips;
+    std::vector<uint8_t> alphas;
+
+    std::vector<DrawOp> ops;
+    std::vector<char> textBytes;
+    std::vector<std::vector<uint32_t>> bins;    // Per tile: op indices in submission order
+    std::vector<uint32_t> touched;
+    std::vector<std::vector<uint32_t>> scratch; // Per worker tile buffer
+    std::unordered_map<uint32_t, Surface> surfaces;
+    TilePool pool;
+    FrameStats stats{};
+
+    Clip transformRect(float x, float y, float w, float h) const;
+    bool clipOp(DrawOp& op, const Clip& r) const;
+    void bin(const DrawOp& op);
+    void rasterTile(uint32_t tile, uint32_t* buf);
+    void fillSpan(uint32_t* buf, const DrawOp& op, const Clip& area, int tileX, int tileY);
+    void blitSpan(uint32_t* buf, const DrawOp& op, const Clip& area, int tileX, int tileY);  // sw_blit.cpp
+    void loadTile(uint32_t tile, uint32_t* buf, Clip& area);                                // sw_flush.cpp
+    void storeTile(const uint32_t* buf, const Clip& area);
+};
+
+// Blend src over dst with a 0..255 coverage; result is opaque (framebuffer format)
+inline uint32_t blendOver(uint32_t dst, uint32_t src, uint32_t a) {
+    uint32_t ia = 255 - a;
+    uint32_t rb = ((src & 0xFF00FF) * a + (dst & 0xFF00FF) * ia + 0x800080) >> 8;
+    uint32_t g = ((src & 0x00FF00) * a + (dst & 0x00FF00) * ia + 0x008000) >> 8;
+    return 0xFF000000 | (rb & 0xFF00FF) | (g & 0x00FF00);
+}
+
+SoftwareRenderer* defaultRenderer();
+
+struct SoftwareBenchResult {
+    double fullFrameMs;         // Every tile touched
+    double partialFrameMs;      // One widget changed
+    double singleThreadFullMs;
+    uint32_t partialTiles;
+    uint32_t tilesTotal;
+};
+
+SoftwareBenchResult benchmarkSoftware(int width, int height, int frames);
+
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "../api/gui_handle.hpp"
+
+namespace palisade::gui::scene {
+
+using api::Handle;
+
+struct Node {
+    uint64_t id;
+    int x, y;
+};
+
+// 2D affine: [a c tx; b d ty]
+struct Transform2D {
+    float a = 1, b = 0, c = 0, d = 1, tx = 0, ty = 0;
+
+    static Transform2D translate(float x, float y) { return {1, 0, 0, 1, x, y}; }
+};
+
+struct Bounds {
+    float x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+};
+
+// Flat scenegraph. Node data lives in parallel (SoA) arrays kept in pre-order,
+// so a subtree is the contiguous range [i, subtreeEnd[i]) and world transforms
+// update in one forward sweep (parents always precede children). Topology edits
+// only relink; the arrays are re-linearized lazily on the next update().
+class SceneGraph {
+public:
+    static constexpr uint32_t kNone = 0xFFFFFFFFu;
+
+    Handle create(Handle parent = {});
+    void destroy(Handle h);                   // Node and its whole subtree
+    void reparent(Handle h, Handle newParent);
+    bool valid(Handle h) const { return handles.valid(h); }
+
+    void setLocal(Handle h, const Transform2D& t);
+    void setBounds(Handle h, const Bounds& local);
+    const Transform2D* world(Handle h) const;
+    const Bounds* worldBounds(Handle h) const;
+
+    // Recomputes world data for moved subtrees only; returns nodes recomputed
+    uint32_t update();
+
+    uint32_t size() const { return static_cast<uint32_t>(handleOf.size()); }
+
+    // Pre-order visit: f(Handle, const Transform2D& world, const Bounds& worldBounds)
+    template <typename F>
+    void forEach(F&& f) {
+        update();
+        for (uint32_t i = 0; i < handleOf.size(); i++) {
+            f(handleOf[i], world_[i], worldBounds_[i]);
+        }
+    }
+
+private:
+    api::HandlePool handles;
+    std::vector<uint32_t> denseOf;    // Handle index -> dense position (kNone if free)
+    std::vector<Handle> handleOf;     // Dense position -> handle
+
+    // SoA node data, indexed by dense position
+    std::vector<uint32_t> parent;
+    std::vector<uint32_t> firstChild;
+    std::vector<uint32_t> lastChild;
+    std::vector<uint32_t> nextSibling;
+    std::vector<uint32_t> subtreeEnd;     // Valid while !topologyDirty
+    std::vector<Transform2D> local;
+    std::vector<Transform2D> world_;
+    std::vector<Bounds> localBounds;
+    std::vector<Bounds> worldBounds_;
+    std::vector<uint8_t> dirty;
+
+    uint32_t firstRoot = kNone, lastRoot = kNone;
+    std::vector<uint32_t> dirtyRoots;
+    bool topologyDirty = false;
+
+    uint32_t dense(Handle h) const;
+    void link(uint32_t node, uint32_t newParent);
+    void unlink(uint32_t node);
+    void markDirty(uint32_t node);
+    void relinearize();
+    void computeNode(uint32_t i);
+};
+
+struct SceneBenchResult {
+    uint32_t nodes;
+    uint64_t fullNs;            // Every world transform recomputed
+    uint64_t incrementalNs;     // Only moved subtrees recomputed
+    uint32_t incrementalNodes;
+};
+
+SceneBenchResult benchmarkWorldTransforms(uint32_t nodeCount, uint32_t movedSubtrees);
+
+}
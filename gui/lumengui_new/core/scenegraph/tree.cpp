@@ -0,0 +1,282 @@
+#include "node.hpp"
+#include <algorithm>
+#include <chrono>
+#include <type_traits>
+
+namespace palisade::gui::scene {
+
+static Transform2D multiply(const Transform2D& p, const Transform2D& l) {
+    return {
+        p.a * l.a + p.c * l.b,
+        p.b * l.a + p.d * l.b,
+        p.a * l.c + p.c * l.d,
+        p.b * l.c + p.d * l.d,
+        p.a * l.tx + p.c * l.ty + p.tx,
+        p.b * l.tx + p.d * l.ty + p.ty,
+    };
+}
+
+static Bounds transformBounds(const Transform2D& m, const Bounds& b) {
+    float xs[4] = {b.x0, b.x1, b.x0, b.x1};
+    float ys[4] = {b.y0, b.y0, b.y1, b.y1};
+    Bounds out;
+    for (int k = 0; k < 4; k++) {
+        float x = m.a * xs[k] + m.c * ys[k] + m.tx;
+        float y = m.b * xs[k] + m.d * ys[k] + m.ty;
+        if (k == 0 || x < out.x0) out.x0 = x;
+        if (k == 0 || x > out.x1) out.x1 = x;
+        if (k == 0 || y < out.y0) out.y0 = y;
+        if (k == 0 || y > out.y1) out.y1 = y;
+    }
+    return out;
+}
+
+uint32_t SceneGraph::dense(Handle h) const {
+    return handles.valid(h) ? denseOf[h.index] : kNone;
+}
+
+Handle SceneGraph::create(Handle parentHandle) {
+    uint32_t p = kNone;
+    if (parentHandle) {
+        p = dense(parentHandle);
+        if (p == kNone) return {};  // Stale parent
+    }
+
+    Handle h = handles.acquire();
+    uint32_t i = size();
+    if (denseOf.size() < handles.capacity()) denseOf.resize(handles.capacity(), kNone);
+    denseOf[h.index] = i;
+    handleOf.push_back(h);
+
+    parent.push_back(kNone);
+    firstChild.push_back(kNone);
+    lastChild.push_back(kNone);
+    nextSibling.push_back(kNone);
+    subtreeEnd.push_back(i + 1);
+    local.emplace_back();
+    world_.emplace_back();
+    localBounds.emplace_back();
+    worldBounds_.emplace_back();
+    dirty.push_back(0);
+
+    link(i, p);
+    markDirty(i);
+    topologyDirty = true;
+    return h;
+}
+
+void SceneGraph::link(uint32_t node, uint32_t newParent) {
+    parent[node] = newParent;
+    nextSibling[node] = kNone;
+    uint32_t& first = newParent == kNone ? firstRoot : firstChild[newParent];
+    uint32_t& last = newParent == kNone ? lastRoot : lastChild[newParent];
+    if (last == kNone) {
+        first = node;
+    } else {
+        nextSibling[last] = node;
+    }
+    last = node;
+}
+
+void SceneGraph::unlink(uint32_t node) {
+    uint32_t p = parent[node];
+    uint32_t& first = p == kNone ? firstRoot : firstChild[p];
+    uint32_t& last = p == kNone ? lastRoot : lastChild[p];
+    uint32_t prev = kNone;
+    for (uint32_t n = first; n != node; n = nextSibling[n]) prev = n;
+    if (prev == kNone) first = nextSibling[node];
+    else nextSibling[prev] = nextSibling[node];
+    if (last == node) last = prev;
+    parent[node] = kNone;
+    nextSibling[node] = kNone;
+}
+
+void SceneGraph::destroy(Handle h) {
+    uint32_t i = dense(h);
+    if (i == kNone) return;
+    unlink(i);
+
+    // Free the whole subtree; its dense slots are dropped at the next relinearize
+    std::vector<uint32_t> stack{i};
+    while (!stack.empty()) {
+        uint32_t n = stack.back();
+        stack.pop_back();
+        for (uint32_t c = firstChild[n]; c != kNone; c = nextSibling[c]) stack.push_back(c);
+        denseOf[handleOf[n].index] = kNone;
+        handles.release(handleOf[n]);
+    }
+    topologyDirty = true;
+}
+
+void SceneGraph::reparent(Handle h, Handle newParent) {
+    uint32_t i = dense(h);
+    uint32_t p = newParent ? dense(newParent) : kNone;
+    if (i == kNone || (newParent && p == kNone)) return;
+    for (uint32_t a = p; a != kNone; a = parent[a]) {
+        if (a == i) return;  // Would create a cycle
+    }
+    unlink(i);
+    link(i, p);
+    markDirty(i);
+    topologyDirty = true;
+}
+
+void SceneGraph::markDirty(uint32_t node) {
+    if (dirty[node]) return;
+    dirty[node] = 1;
+    dirtyRoots.push_back(node);
+}
+
+void SceneGraph::setLocal(Handle h, const Transform2D& t) {
+    uint32_t i = dense(h);
+    if (i == kNone) return;
+    local[i] = t;
+    markDirty(i);
+}
+
+void SceneGraph::setBounds(Handle h, const Bounds& b) {
+    uint32_t i = dense(h);
+    if (i == kNone) return;
+    localBounds[i] = b;
+    markDirty(i);
+}
+
+const Transform2D* SceneGraph::world(Handle h) const {
+    uint32_t i = dense(h);
+    return i == kNone ? nullptr : &world_[i];
+}
+
+const Bounds* SceneGraph::worldBounds(Handle h) const {
+    uint32_t i = dense(h);
+    return i == kNone ? nullptr : &worldBounds_[i];
+}
+
+// Permutes every array into pre-order and drops destroyed nodes
+void SceneGraph::relinearize() {
+    std::vector<uint32_t> order;
+    order.reserve(handleOf.size());
+    for (uint32_t n = firstRoot; n != kNone;) {
+        order.push_back(n);
+        if (firstChild[n] != kNone) {
+            n = firstChild[n];
+            continue;
+        }
+        while (n != kNone && nextSibling[n] == kNone) n = parent[n];
+        if (n != kNone) n = nextSibling[n];
+    }
+
+    std::vector<uint32_t> newPos(handleOf.size(), kNone);
+    for (uint32_t k = 0; k < order.size(); k++) newPos[order[k]] = k;
+    auto remap = [&](uint32_t v) { return v == kNone ? kNone : newPos[v]; };
+
+    auto permute = [&](auto& v) {
+        std::remove_reference_t<decltype(v)> out;
+        out.reserve(order.size());
+        for (uint32_t old : order) out.push_back(v[old]);
+        v.swap(out);
+    };
+    auto permuteLinks = [&](std::vector<uint32_t>& v) {
+        std::vector<uint32_t> out;
+        out.reserve(order.size());
+        for (uint32_t old : order) out.push_back(remap(v[old]));
+        v.swap(out);
+    };
+
+    permuteLinks(parent);
+    permuteLinks(firstChild);
+    permuteLinks(lastChild);
+    permuteLinks(nextSibling);
+    permute(handleOf);
+    permute(local);
+    permute(world_);
+    permute(localBounds);
+    permute(worldBounds_);
+    permute(dirty);
+    firstRoot = remap(firstRoot);
+    lastRoot = remap(lastRoot);
+    for (uint32_t k = 0; k < handleOf.size(); k++) denseOf[handleOf[k].index] = k;
+
+    // Children follow their parent in pre-order, so one backward pass sizes every subtree
+    subtreeEnd.resize(order.size());
+    for (uint32_t k = 0; k < order.size(); k++) subtreeEnd[k] = k + 1;
+    for (uint32_t k = static_cast<uint32_t>(order.size()); k-- > 0;) {
+        if (parent[k] != kNone) subtreeEnd[parent[k]] = std::max(subtreeEnd[parent[k]], subtreeEnd[k]);
+    }
+
+    dirtyRoots.clear();
+    topologyDirty = false;
+}
+
+void SceneGraph::computeNode(uint32_t i) {
+    uint32_t p = parent[i];
+    world_[i] = p == kNone ? local[i] : multiply(world_[p], local[i]);
+    worldBounds_[i] = transformBounds(world_[i], localBounds[i]);
+    dirty[i] = 0;
+}
+
+uint32_t SceneGraph::update() {
+    if (topologyDirty) {
+        relinearize();
+        for (uint32_t i = 0; i < size(); i++) computeNode(i);
+        return size();
+    }
+    if (dirtyRoots.empty()) return 0;
+
+    // Ascending order visits ancestors first; a covered descendant is already clean
+    std::sort(dirtyRoots.begin(), dirtyRoots.end());
+    uint32_t count = 0;
+    for (uint32_t r : dirtyRoots) {
+        if (!dirty[r]) continue;
+        for (uint32_t k = r; k < subtreeEnd[r]; k++) computeNode(k);
+        count += subtreeEnd[r] - r;
+    }
+    dirtyRoots.clear();
+    return count;
+}
+
+// World transform update cost: whole tree vs. a few moved subtrees
+SceneBenchResult benchmarkWorldTransforms(uint32_t nodeCount, uint32_t movedSubtrees) {
+    using clock = std::chrono::steady_clock;
+    constexpr int kRounds = 32;
+
+    SceneGraph graph;
+    std::vector<Handle> nodes;
+    nodes.reserve(nodeCount);
+    nodes.push_back(graph.create());
+    for (uint32_t i = 1; i < nodeCount; i++) {
+        // ~8 children per node: a wide, shallow UI-like tree
+        Handle h = graph.create(nodes[(i - 1) / 8]);
+        graph.setLocal(h, Transform2D::translate(static_cast<float>(i % 97), static_cast<float>(i % 53)));
+        graph.setBounds(h, {0, 0, 64, 32});
+        nodes.push_back(h);
+    }
+    graph.update();
+
+    SceneBenchResult result{graph.size(), 0, 0, 0};
+
+    auto t0 = clock::now();
+    for (int r = 0; r < kRounds; r++) {
+        graph.setLocal(nodes[0], Transform2D::translate(static_cast<float>(r), 0));
+        graph.update();
+    }
+    auto t1 = clock::now();
+
+    uint32_t seed = 0x2545F491u;
+    uint32_t recomputed = 0;
+    for (int r = 0; r < kRounds; r++) {
+        for (uint32_t m = 0; m < movedSubtrees; m++) {
+            seed = seed * 1664525u + 1013904223u;
+            Handle h = nodes[nodeCount / 8 + seed % (nodeCount - nodeCount / 8)];  // Below the top levels
+            graph.setLocal(h, Transform2D::translate(static_cast<float>(r), static_cast<float>(m)));
+        }
+        recomputed += graph.update();
+    }
+    auto t2 = clock::now();
+
+    result.fullNs = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count() / kRounds;
+    result.incrementalNs = std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count() / kRounds;
+    result.incrementalNodes = recomputed / kRounds;
+    return result;
+}
+
+}
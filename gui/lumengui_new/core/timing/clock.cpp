@@ -0,0 +1,21 @@
+#include "clock.hpp"
+#include <errno.h>
+#include <time.h>
+
+namespace palisade::gui::time {
+
+uint64_t now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+// Absolute deadline: no drift from the time spent before the call
+void sleepUntil(uint64_t deadline) {
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(deadline / 1000000000ull);
+    ts.tv_nsec = static_cast<long>(deadline % 1000000000ull);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+}
+
+}
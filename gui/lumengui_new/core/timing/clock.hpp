@@ -0,0 +1,9 @@
+#pragma once
+#include <stdint.h>
+
+namespace palisade::gui::time {
+
+uint64_t now();                     // Monotonic nanoseconds
+void sleepUntil(uint64_t deadline); // Absolute, on the same clock
+
+}
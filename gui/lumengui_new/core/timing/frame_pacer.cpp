@@ -0,0 +1,99 @@
+#include "frame_pacer.hpp"
+#include "clock.hpp"
+#include <chrono>
+
+namespace palisade::gui::time {
+
+FramePacer::FramePacer(uint64_t intervalNs) : interval(intervalNs ? intervalNs : 16666667) {}
+
+void FramePacer::invalidate(uint32_t reasons) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pendingReasons |= reasons;
+    }
+    wake.notify_one();
+}
+
+void FramePacer::scheduleAt(uint64_t deadline, uint32_t reasons) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!scheduledNs || deadline < scheduledNs) scheduledNs = deadline;
+        scheduledReasons |= reasons;
+    }
+    wake.notify_one();
+}
+
+// Display timing from the compositor/driver, when known. Usually reported
+// from another thread, so it is handed over under the lock and the render
+// thread's interval/phase pair only changes inside waitForFrame().
+void FramePacer::setVsync(uint64_t timestamp, uint64_t intervalNs) {
+    std::lock_guard<std::mutex> lock(mutex);
+    vsyncNs = timestamp;
+    vsyncInterval = intervalNs;
+    vsyncPending = true;
+}
+
+uint32_t FramePacer::pending() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return pendingReasons;
+}
+
+uint32_t FramePacer::waitForFrame() {
+    uint32_t reasons;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            uint64_t t = now();
+            if (scheduledNs && scheduledNs <= t) {
+                pendingReasons |= scheduledReasons;
+                scheduledNs = 0;
+                scheduledReasons = 0;
+            }
+            if (pendingReasons) break;
+            if (scheduledNs) wake.wait_for(lock, std::chrono::nanoseconds(scheduledNs - t));
+            else wake.wait(lock);
+            stats_.wakeups++;
+        }
+        reasons = pendingReasons;
+        pendingReasons = 0;
+        if (vsyncPending) {
+            if (vsyncInterval) interval = vsyncInterval;
+            phase = vsyncNs % interval;
+            vsyncPending = false;
+        }
+    }
+
+    // Target the first unused vsync that still leaves room for the predicted
+    // work (+25% and 1 ms margin, capped at one interval)
+    uint64_t budget = stats_.workEmaNs + stats_.workEmaNs / 4 + 1000000;
+    if (budget > interval) budget = interval;
+    uint64_t t = now();
+    uint64_t slot = (t + budget - phase) / interval + 1;
+    if (slot <= lastSlot) slot = lastSlot + 1;
+    lastSlot = slot;
+    frameVsync = phase + slot * interval;
+
+    uint64_t start = frameVsync - budget;
+    if (start > t) sleepUntil(start);
+    frameStart = now();
+    return reasons;
+}
+
+void FramePacer::frameDone() {
+    uint64_t t = now();
+    uint64_t work = t - frameStart;
+    stats_.workEmaNs = stats_.frames ? (stats_.workEmaNs * 7 + work) / 8 : work;
+    stats_.frames++;
+    if (t > frameVsync) stats_.missed++;
+}
+
+FramePacer& framePacer() {
+    static FramePacer pacer;
+    return pacer;
+}
+
+bool shouldRender() {
+    return framePacer().pending() != 0;
+}
+
+}
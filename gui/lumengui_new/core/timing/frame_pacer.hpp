@@ -0,0 +1,62 @@
+#pragma once
+#include <stdint.h>
+#include <condition_variable>
+#include <mutex>
+
+namespace palisade::gui::time {
+
+enum FrameReason : uint32_t {
+    FrameInput = 1u << 0,
+    FrameAnimation = 1u << 1,
+    FrameState = 1u << 2,
+    FrameResize = 1u << 3,
+    FrameClient = 1u << 4,      // Wayland client requests waiting (core/wayland)
+};
+
+struct PacerStats {
+    uint64_t frames;
+    uint64_t missed;        // Finished after the vsync it was scheduled for
+    uint64_t wakeups;       // Loop wakeups, including spurious ones
+    uint64_t workEmaNs;     // Predicted frame work
+};
+
+// Renders only when invalidated. Frame starts are placed so the predicted
+// work ends on a vsync (phase + k * interval), at most one frame per
+// interval; with nothing pending the render thread blocks without timeout.
+class FramePacer {
+public:
+    explicit FramePacer(uint64_t intervalNs = 16666667);
+
+    void invalidate(uint32_t reasons);                  // Any thread
+    void scheduleAt(uint64_t deadline, uint32_t reasons); // Timed invalidation (earliest wins)
+    void setVsync(uint64_t timestamp, uint64_t intervalNs); // Any thread; applied at the next frame
+
+    uint32_t waitForFrame();    // Blocks; returns the reasons being served
+    void frameDone();
+    uint32_t pending() const;
+
+    const PacerStats& stats() const { return stats_; }
+
+private:
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    uint32_t pendingReasons = 0;
+    uint32_t scheduledReasons = 0;
+    uint64_t scheduledNs = 0;
+    uint64_t vsyncNs = 0;
+    uint64_t vsyncInterval = 0;
+    bool vsyncPending = false;
+
+    // Render thread only
+    uint64_t interval;
+    uint64_t phase = 0;
+    uint64_t lastSlot = 0;
+    uint64_t frameStart = 0;
+    uint64_t frameVsync = 0;
+    PacerStats stats_{};
+};
+
+FramePacer& framePacer();
+bool shouldRender();    // Poll-style loops: anything pending on the shared pacer
+
+}
@@ -0,0 +1,138 @@
+#include "wl_internal.hpp"
+#include "../timing/frame_pacer.hpp"
+#include <wayland-server-protocol.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace palisade::gui::wayland {
+
+Compositor::~Compositor() {
+    stop();
+}
+
+bool Compositor::start(const CompositorConfig& config) {
+    if (display) return true;
+    cfg = config;
+    if (cfg.layerCount <= 0) return false;
+
+    display = wl_display_create();
+    if (!display) return false;
+    if (cfg.socket) {
+        socket = wl_display_add_socket(display, cfg.socket) == 0 ? cfg.socket : nullptr;
+    } else {
+        socket = wl_display_add_socket_auto(display);
+    }
+    globals[0] = createCompositorGlobal(display, this);
+    globals[1] = createShmGlobal(display);
+    globals[2] = createXdgShellGlobal(display, this);
+    stopFd = eventfd(0, EFD_CLOEXEC);
+    if (!socket || !globals[0] || !globals[1] || !globals[2] || stopFd < 0) {
+        wl_display_destroy(display);
+        display = nullptr;
+        if (stopFd >= 0) close(stopFd);
+        stopFd = -1;
+        return false;
+    }
+
+    loop = wl_display_get_event_loop(display);
+    frames = new wl_list;
+    wl_list_init(frames);
+    layerOwners.assign(cfg.layerCount, nullptr);
+    stats_ = CompositorStats{};
+    stopping.store(false, std::memory_order_relaxed);
+    watchArmed = true;
+    watcher = std::thread(&Compositor::watch, this, wl_event_loop_get_fd(loop));
+    return true;
+}
+
+void Compositor::stop() {
+    if (!display) return;
+    stopping.store(true, std::memory_order_relaxed);
+    uint64_t one = 1;
+    (void)!::write(stopFd, &one, sizeof(one));
+    {
+        std::lock_guard<std::mutex> lock(watchMutex);
+        watchArmed = true;
+    }
+    watchWake.notify_one();
+    watcher.join();
+    close(stopFd);
+    stopFd = -1;
+
+    // Surfaces detach their layers as their clients go
+    wl_display_destroy_clients(display);
+    wl_display_destroy(display);
+    display = nullptr;
+    loop = nullptr;
+    socket = nullptr;
+    delete frames;
+    frames = nullptr;
+    layerOwners.clear();
+}
+
+// Watcher thread: the render thread only wakes for invalidations, so client
+// traffic arriving while it sleeps asks the pacer for a frame. One wakeup per
+// dispatch; the fd stays readable until the render thread drains it.
+void Compositor::watch(int loopFd) {
+    pollfd fds[2] = {{loopFd, POLLIN, 0}, {stopFd, POLLIN, 0}};
+    while (!stopping.load(std::memory_order_relaxed)) {
+        {
+            std::unique_lock<std::mutex> lock(watchMutex);
+            watchWake.wait(lock, [this] { return watchArmed; });
+        }
+        if (poll(fds, 2, -1) < 0 || (fds[1].revents & POLLIN)) continue;
+        {
+            std::lock_guard<std::mutex> lock(watchMutex);
+            watchArmed = false;
+        }
+        time::framePacer().invalidate(time::FrameClient);
+    }
+}
+
+void Compositor::dispatch() {
+    if (!display) return;
+    stats_.poolFaults += failTruncatedPools();
+    wl_event_loop_dispatch(loop, 0);
+    wl_display_flush_clients(display);
+    {
+        std::lock_guard<std::mutex> lock(watchMutex);
+        watchArmed = true;
+    }
+    watchWake.notify_one();
+}
+
+// The frame is on screen: clients may draw their next one
+void Compositor::presented(uint64_t timeNs) {
+    if (!display) return;
+    uint32_t ms = static_cast<uint32_t>(timeNs / 1000000);
+    wl_resource* cb;
+    wl_resource* next;
+    wl_resource_for_each_safe(cb, next, frames) {
+        wl_callback_send_done(cb, ms);
+        wl_resource_destroy(cb);
+        stats_.framesDone++;
+    }
+    wl_display_flush_clients(display);
+}
+
+int Compositor::acquireLayer(Surface* s) {
+    for (size_t i = 0; i < layerOwners.size(); i++) {
+        if (layerOwners[i]) continue;
+        layerOwners[i] = s;
+        return cfg.firstLayer + static_cast<int>(i);
+    }
+    return -1;  // Out of layers: the surface stays unmapped
+}
+
+void Compositor::releaseLayer(int layer) {
+    int i = layer - cfg.firstLayer;
+    if (i >= 0 && i < static_cast<int>(layerOwners.size())) layerOwners[i] = nullptr;
+}
+
+Compositor& compositor() {
+    static Compositor instance;
+    return instance;
+}
+
+}
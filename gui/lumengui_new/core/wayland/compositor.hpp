@@ -0,0 +1,93 @@
+#pragma once
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct wl_display;
+struct wl_event_loop;
+struct wl_global;
+struct wl_list;
+
+namespace palisade::gui::wayland {
+
+struct CompositorConfig {
+    const char* socket = nullptr;   // nullptr = first free wayland-N
+    int firstLayer = 4;             // sys2Dengine layers handed to client surfaces
+    int layerCount = 8;
+    int width = 1440;               // Size offered to toplevels
+    int height = 2560;
+};
+
+struct CompositorStats {
+    uint64_t commits;
+    uint64_t attaches;              // Buffers bound to a layer in place (never copied)
+    uint64_t damagedPixels;         // Area clients reported, after clipping
+    uint64_t framesDone;            // Frame callbacks answered
+    uint64_t poolFaults;            // Pools truncated under us (client disconnected)
+    uint32_t mappedSurfaces;
+};
+
+struct Surface;
+struct ShmPool;
+
+// Minimal Wayland frontend: wl_compositor (v4, damage_buffer), wl_shm and
+// xdg_shell v1. Client wl_shm pools are mapped once and their buffers become
+// sys2Dengine layer backing stores directly, so a client frame costs no pixel
+// copies; damage goes to the layer's damage rect and frame callbacks are
+// answered from presented(), which throttles clients to our present rate.
+//
+// Everything except the watcher runs on the render thread: dispatch() at the
+// start of a frame, presented() once it is on screen.
+class Compositor {
+public:
+    Compositor() = default;
+    ~Compositor();
+
+    bool start(const CompositorConfig& cfg);
+    void stop();
+    const char* socketName() const { return socket; }
+
+    void dispatch();                    // Run queued client requests
+    void presented(uint64_t timeNs);    // Answer frame callbacks, flush clients
+    const CompositorStats& stats() const { return stats_; }
+
+    // Internal (wl_surface.cpp / xdg_shell.cpp)
+    const CompositorConfig& config() const { return cfg; }
+    int acquireLayer(Surface* s);
+    void releaseLayer(int layer);
+    wl_list* frameList() { return frames; }
+    CompositorStats& counters() { return stats_; }
+
+private:
+    CompositorConfig cfg;
+    wl_display* display = nullptr;
+    wl_event_loop* loop = nullptr;
+    wl_global* globals[3] = {};
+    const char* socket = nullptr;
+    wl_list* frames = nullptr;          // Committed wl_callbacks waiting for a present
+    std::vector<Surface*> layerOwners;
+    CompositorStats stats_{};
+
+    // Wakes the frame pacer when clients send something while the render
+    // thread is idle; re-armed by each dispatch()
+    std::thread watcher;
+    std::mutex watchMutex;
+    std::condition_variable watchWake;
+    bool watchArmed = true;
+    std::atomic<bool> stopping{false};
+    int stopFd = -1;
+
+    void watch(int loopFd);
+};
+
+Compositor& compositor();
+
+// Shm pool SIGBUS guard (wl_shm.cpp): pools whose file was truncated are
+// replaced by zero pages; the owner is disconnected at the next dispatch.
+// Returns the number of clients failed.
+int failTruncatedPools();
+
+}
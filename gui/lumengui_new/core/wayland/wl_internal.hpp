@@ -0,0 +1,106 @@
+#pragma once
+#include "compositor.hpp"
+#include <wayland-server-core.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// Protocol objects shared by the frontend's translation units. Lifetimes
+// follow the protocol: a pool outlives its resource while buffers still use
+// it, and a buffer outlives its resource while a surface scans out of it.
+
+namespace palisade::gui::wayland {
+
+struct Rect {
+    int32_t x0 = 0, y0 = 0, x1 = 0, y1 = 0;     // Exclusive max; empty when x1 <= x0
+
+    bool empty() const { return x1 <= x0 || y1 <= y0; }
+    void add(int32_t x, int32_t y, int32_t w, int32_t h);
+    void clip(int32_t w, int32_t h);
+};
+
+struct ShmBuffer;
+
+struct ShmPool {
+    wl_resource* resource;          // nullptr once the client destroyed it
+    wl_client* client;
+    uint8_t* data;
+    size_t size;
+    int guard;                      // Slot in the SIGBUS table
+    int refs;                       // Resource + buffers
+    std::vector<ShmBuffer*> buffers;
+};
+
+struct ShmBuffer {
+    wl_resource* resource;          // nullptr once the client destroyed it
+    ShmPool* pool;
+    int32_t offset, width, height, stride;
+    uint32_t format;
+    int refs;                       // Resource + the surface showing it
+    Surface* scanout;               // Surface whose layer reads these pixels
+
+    uint32_t* pixels() const { return reinterpret_cast<uint32_t*>(pool->data + offset); }
+};
+
+ShmBuffer* shmBufferFromResource(wl_resource* resource);
+void shmBufferRef(ShmBuffer* b);
+void shmBufferUnref(ShmBuffer* b);
+wl_global* createShmGlobal(wl_display* display);
+
+struct XdgSurface;
+
+struct PendingBufferWatch {
+    wl_listener listener;           // First member: the notify casts back
+    Surface* surface;
+};
+
+struct SurfaceState {
+    bool attached = false;          // attach() since the last commit (buffer may be null)
+    ShmBuffer* buffer = nullptr;    // Not referenced until committed
+    PendingBufferWatch bufferWatch; // Clears buffer if the client destroys it first
+    Rect damage;                    // Surface coordinates
+    Rect bufferDamage;              // Buffer coordinates
+    int32_t scale = 1;
+    wl_list frames;
+};
+
+struct Surface {
+    wl_resource* resource;
+    Compositor* owner;
+    SurfaceState pending;
+    ShmBuffer* buffer = nullptr;    // Current, referenced
+    int32_t scale = 1;
+    int layer = -1;                 // sys2Dengine layer while mapped
+    int32_t x = 0, y = 0;
+    XdgSurface* xdg = nullptr;      // Role, if any
+
+    void commit();
+    void rebind();                  // The pool moved: point the layer at the new mapping
+    void unmap();
+};
+
+Surface* surfaceFromResource(wl_resource* resource);
+wl_global* createCompositorGlobal(wl_display* display, Compositor* owner);
+
+struct XdgSurface {
+    enum Role : uint8_t { None, Toplevel, Popup };
+
+    wl_resource* resource;
+    wl_resource* role = nullptr;    // xdg_toplevel / xdg_popup
+    Surface* surface;
+    Role kind = None;
+    bool configureSent = false;
+    bool configured = false;        // A configure was acked
+    bool mapped = false;            // A buffer was committed after the ack
+    uint32_t serial = 0;
+    int32_t popupX = 0, popupY = 0;     // Screen position, resolved at get_popup
+    int32_t popupW = 0, popupH = 0;
+    int32_t parentX = 0, parentY = 0;   // Parent position then (configure is relative)
+
+    bool mappable() const { return kind != None && configured; }
+    void surfaceCommitted();        // Initial configure, role checks
+};
+
+wl_global* createXdgShellGlobal(wl_display* display, Compositor* owner);
+
+}
@@ -0,0 +1,270 @@
+#include "wl_internal.hpp"
+#include <wayland-server-protocol.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <atomic>
+
+namespace palisade::gui::wayland {
+
+namespace {
+
+// Pools are read in place by the compositor, so a client that truncates its
+// file would SIGBUS the render thread. The handler swaps the pool's mapping
+// for zero pages (the read retries and sees black) and flags the slot; the
+// client is disconnected at the next dispatch.
+constexpr int kMaxGuards = 256;
+
+struct Guard {
+    std::atomic<uintptr_t> base{0};
+    std::atomic<size_t> size{0};
+    std::atomic<bool> faulted{false};
+    ShmPool* pool = nullptr;        // Render thread only
+};
+
+Guard guards[kMaxGuards];
+
+// Larger than any panel; keeps every size product well inside 64 bits
+constexpr int32_t kMaxBufferDim = 16384;
+struct sigaction previousBus;
+bool handlerInstalled = false;
+
+void onSigbus(int sig, siginfo_t* info, void* context) {
+    uintptr_t addr = reinterpret_cast<uintptr_t>(info->si_addr);
+    for (auto& g : guards) {
+        uintptr_t base = g.base.load(std::memory_order_acquire);
+        size_t size = g.size.load(std::memory_order_acquire);
+        if (!base || addr < base || addr >= base + size) continue;
+        if (mmap(reinterpret_cast<void*>(base), size, PROT_READ,
+                 MAP_PRIVATE | MAP_FIXED | MAP_ANONYMOUS, -1, 0) == MAP_FAILED) break;
+        g.faulted.store(true, std::memory_order_release);
+        return;
+    }
+
+    // Not ours
+    if (previousBus.sa_flags & SA_SIGINFO) {
+        previousBus.sa_sigaction(sig, info, context);
+    } else if (previousBus.sa_handler != SIG_DFL && previousBus.sa_handler != SIG_IGN) {
+        previousBus.sa_handler(sig);
+    } else {
+        signal(SIGBUS, SIG_DFL);
+        raise(SIGBUS);
+    }
+}
+
+int guardAcquire(ShmPool* pool) {
+    if (!handlerInstalled) {
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_sigaction = onSigbus;
+        sa.sa_flags = SA_SIGINFO | SA_NODEFER;
+        sigemptyset(&sa.sa_mask);
+        sigaction(SIGBUS, &sa, &previousBus);
+        handlerInstalled = true;
+    }
+    for (int i = 0; i < kMaxGuards; i++) {
+        Guard& g = guards[i];
+        if (g.pool) continue;
+        g.pool = pool;
+        g.faulted.store(false, std::memory_order_relaxed);
+        g.size.store(pool->size, std::memory_order_relaxed);
+        g.base.store(reinterpret_cast<uintptr_t>(pool->data), std::memory_order_release);
+        return i;
+    }
+    return -1;
+}
+
+// Base first, so the handler never pairs a stale base with a new size
+void guardUpdate(int slot, const ShmPool* pool) {
+    Guard& g = guards[slot];
+    g.base.store(0, std::memory_order_release);
+    g.size.store(pool->size, std::memory_order_relaxed);
+    g.base.store(reinterpret_cast<uintptr_t>(pool->data), std::memory_order_release);
+}
+
+void guardRelease(int slot) {
+    guards[slot].base.store(0, std::memory_order_release);
+    guards[slot].pool = nullptr;
+}
+
+void poolUnref(ShmPool* pool) {
+    if (--pool->refs > 0) return;
+    if (pool->guard >= 0) guardRelease(pool->guard);
+    munmap(pool->data, pool->size);
+    delete pool;
+}
+
+void bufferDestroyRequest(wl_client*, wl_resource* resource) {
+    wl_resource_destroy(resource);
+}
+
+const struct wl_buffer_interface kBufferImpl = {
+    bufferDestroyRequest,
+};
+
+void bufferResourceDestroyed(wl_resource* resource) {
+    auto* b = static_cast<ShmBuffer*>(wl_resource_get_user_data(resource));
+    b->resource = nullptr;
+    shmBufferUnref(b);
+}
+
+void poolCreateBuffer(wl_client* client, wl_resource* resource, uint32_t id, int32_t offset,
+                      int32_t width, int32_t height, int32_t stride, uint32_t format) {
+    auto* pool = static_cast<ShmPool*>(wl_resource_get_user_data(resource));
+    if (format != WL_SHM_FORMAT_ARGB8888 && format != WL_SHM_FORMAT_XRGB8888) {
+        wl_resource_post_error(resource, WL_SHM_ERROR_INVALID_FORMAT, "unsupported format 0x%x", format);
+        return;
+    }
+    // Rows must be whole pixels: layers address them by pixel stride
+    if (offset < 0 || width <= 0 || height <= 0 || width > kMaxBufferDim || height > kMaxBufferDim ||
+        stride <= 0 || static_cast<int64_t>(stride) < static_cast<int64_t>(width) * 4 || stride % 4 ||
+        static_cast<uint64_t>(offset) + static_cast<uint64_t>(stride) * static_cast<uint64_t>(height) > pool->size) {
+        wl_resource_post_error(resource, WL_SHM_ERROR_INVALID_STRIDE, "invalid buffer %dx%d stride %d offset %d",
+                               width, height, stride, offset);
+        return;
+    }
+
+    auto* b = new ShmBuffer{nullptr, pool, offset, width, height, stride, format, 1, nullptr};
+    b->resource = wl_resource_create(client, &wl_buffer_interface, 1, id);
+    if (!b->resource) {
+        delete b;
+        wl_resource_post_no_memory(resource);
+        return;
+    }
+    wl_resource_set_implementation(b->resource, &kBufferImpl, b, bufferResourceDestroyed);
+    pool->refs++;
+    pool->buffers.push_back(b);
+}
+
+void poolDestroyRequest(wl_client*, wl_resource* resource) {
+    wl_resource_destroy(resource);
+}
+
+// Pools may only grow. The mapping can move, so layers showing one of its
+// buffers are repointed before anything composites again.
+void poolResize(wl_client*, wl_resource* resource, int32_t size) {
+    auto* pool = static_cast<ShmPool*>(wl_resource_get_user_data(resource));
+    if (size < 0 || static_cast<size_t>(size) < pool->size) {
+        wl_resource_post_error(resource, WL_SHM_ERROR_INVALID_FD, "shrinking pool invalid");
+        return;
+    }
+    if (static_cast<size_t>(size) == pool->size) return;
+
+    void* data = mremap(pool->data, pool->size, size, MREMAP_MAYMOVE);
+    if (data == MAP_FAILED) {
+        wl_resource_post_error(resource, WL_SHM_ERROR_INVALID_FD, "failed mremap");
+        return;
+    }
+    pool->data = static_cast<uint8_t*>(data);
+    pool->size = size;
+    if (pool->guard >= 0) guardUpdate(pool->guard, pool);
+    for (ShmBuffer* b : pool->buffers) {
+        if (b->scanout) b->scanout->rebind();
+    }
+}
+
+const struct wl_shm_pool_interface kPoolImpl = {
+    poolCreateBuffer,
+    poolDestroyRequest,
+    poolResize,
+};
+
+void poolResourceDestroyed(wl_resource* resource) {
+    auto* pool = static_cast<ShmPool*>(wl_resource_get_user_data(resource));
+    pool->resource = nullptr;
+    poolUnref(pool);
+}
+
+void shmCreatePool(wl_client* client, wl_resource* resource, uint32_t id, int32_t fd, int32_t size) {
+    if (size <= 0) {
+        wl_resource_post_error(resource, WL_SHM_ERROR_INVALID_STRIDE, "invalid size (%d)", size);
+        close(fd);
+        return;
+    }
+    // Read-only: the compositor never writes client pixels
+    void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        wl_resource_post_error(resource, WL_SHM_ERROR_INVALID_FD, "failed mmap fd %d", fd);
+        return;
+    }
+
+    // Without a guard slot a truncated file would crash the compositor
+    auto* pool = new ShmPool{nullptr, client, static_cast<uint8_t*>(data), static_cast<size_t>(size), -1, 1, {}};
+    pool->guard = guardAcquire(pool);
+    if (pool->guard < 0) {
+        munmap(data, size);
+        delete pool;
+        wl_resource_post_error(resource, WL_SHM_ERROR_INVALID_FD, "too many shm pools (%d)", kMaxGuards);
+        return;
+    }
+    pool->resource = wl_resource_create(client, &wl_shm_pool_interface, 1, id);
+    if (!pool->resource) {
+        guardRelease(pool->guard);
+        munmap(data, size);
+        delete pool;
+        wl_resource_post_no_memory(resource);
+        return;
+    }
+    wl_resource_set_implementation(pool->resource, &kPoolImpl, pool, poolResourceDestroyed);
+}
+
+const struct wl_shm_interface kShmImpl = {
+    shmCreatePool,
+    nullptr,                // release (v2, not advertised)
+};
+
+void bindShm(wl_client* client, void*, uint32_t version, uint32_t id) {
+    wl_resource* resource = wl_resource_create(client, &wl_shm_interface, version, id);
+    if (!resource) {
+        wl_client_post_no_memory(client);
+        return;
+    }
+    wl_resource_set_implementation(resource, &kShmImpl, nullptr, nullptr);
+    wl_shm_send_format(resource, WL_SHM_FORMAT_ARGB8888);
+    wl_shm_send_format(resource, WL_SHM_FORMAT_XRGB8888);
+}
+
+}
+
+ShmBuffer* shmBufferFromResource(wl_resource* resource) {
+    if (!resource || !wl_resource_instance_of(resource, &wl_buffer_interface, &kBufferImpl)) return nullptr;
+    return static_cast<ShmBuffer*>(wl_resource_get_user_data(resource));
+}
+
+void shmBufferRef(ShmBuffer* b) {
+    b->refs++;
+}
+
+void shmBufferUnref(ShmBuffer* b) {
+    if (--b->refs > 0) return;
+    auto& list = b->pool->buffers;
+    for (size_t i = 0; i < list.size(); i++) {
+        if (list[i] == b) {
+            list[i] = list.back();
+            list.pop_back();
+            break;
+        }
+    }
+    poolUnref(b->pool);
+    delete b;
+}
+
+wl_global* createShmGlobal(wl_display* display) {
+    return wl_global_create(display, &wl_shm_interface, 1, nullptr, bindShm);
+}
+
+// Render thread, before compositing: drop clients whose pool was truncated
+int failTruncatedPools() {
+    int failed = 0;
+    for (auto& g : guards) {
+        if (!g.pool || !g.faulted.load(std::memory_order_acquire)) continue;
+        g.faulted.store(false, std::memory_order_relaxed);
+        wl_client_post_implementation_error(g.pool->client, "shm pool truncated while in use");
+        failed++;
+    }
+    return failed;
+}
+
+}
@@ -0,0 +1,288 @@
+#include "wl_internal.hpp"
+#include <wayland-server-protocol.h>
+
+extern "C" {
+#include "../../../../include/system2dengine/sys2Dengine.h"
+}
+
+namespace palisade::gui::wayland {
+
+void Rect::add(int32_t x, int32_t y, int32_t w, int32_t h) {
+    if (w <= 0 || h <= 0) return;
+    // 64-bit ends: clients may send INT32_MAX-sized damage to mean "everything"
+    int64_t ex = static_cast<int64_t>(x) + w, ey = static_cast<int64_t>(y) + h;
+    int32_t cx = ex > INT32_MAX ? INT32_MAX : static_cast<int32_t>(ex);
+    int32_t cy = ey > INT32_MAX ? INT32_MAX : static_cast<int32_t>(ey);
+    if (empty()) {
+        *this = Rect{x, y, cx, cy};
+        return;
+    }
+    if (x < x0) x0 = x;
+    if (y < y0) y0 = y;
+    if (cx > x1) x1 = cx;
+    if (cy > y1) y1 = cy;
+}
+
+void Rect::clip(int32_t w, int32_t h) {
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > w) x1 = w;
+    if (y1 > h) y1 = h;
+}
+
+namespace {
+
+void surfaceDestroyRequest(wl_client*, wl_resource* resource) {
+    wl_resource_destroy(resource);
+}
+
+// A pending buffer the client destroys before committing commits as null
+void pendingBufferDestroyed(wl_listener* listener, void*) {
+    auto* watch = reinterpret_cast<PendingBufferWatch*>(listener);
+    wl_list_remove(&watch->listener.link);
+    wl_list_init(&watch->listener.link);
+    watch->surface->pending.buffer = nullptr;
+}
+
+void setPendingBuffer(Surface* s, ShmBuffer* b) {
+    wl_list_remove(&s->pending.bufferWatch.listener.link);
+    wl_list_init(&s->pending.bufferWatch.listener.link);
+    s->pending.buffer = b;
+    if (b) wl_resource_add_destroy_listener(b->resource, &s->pending.bufferWatch.listener);
+}
+
+void surfaceAttach(wl_client*, wl_resource* resource, wl_resource* buffer, int32_t, int32_t) {
+    Surface* s = surfaceFromResource(resource);
+    ShmBuffer* b = nullptr;
+    if (buffer && !(b = shmBufferFromResource(buffer))) {
+        wl_resource_post_error(resource, WL_DISPLAY_ERROR_INVALID_OBJECT, "only wl_shm buffers are supported");
+        return;
+    }
+    s->pending.attached = true;
+    setPendingBuffer(s, b);
+}
+
+void surfaceDamage(wl_client*, wl_resource* resource, int32_t x, int32_t y, int32_t w, int32_t h) {
+    surfaceFromResource(resource)->pending.damage.add(x, y, w, h);
+}
+
+void callbackUnlink(wl_resource* resource) {
+    wl_list_remove(wl_resource_get_link(resource));
+}
+
+void surfaceFrame(wl_client* client, wl_resource* resource, uint32_t id) {
+    wl_resource* cb = wl_resource_create(client, &wl_callback_interface, 1, id);
+    if (!cb) {
+        wl_resource_post_no_memory(resource);
+        return;
+    }
+    wl_resource_set_implementation(cb, nullptr, nullptr, callbackUnlink);
+    wl_list_insert(surfaceFromResource(resource)->pending.frames.prev, wl_resource_get_link(cb));
+}
+
+// Regions only matter for input and occlusion, which this frontend doesn't do
+void surfaceSetRegion(wl_client*, wl_resource*, wl_resource*) {}
+
+void surfaceCommit(wl_client*, wl_resource* resource) {
+    surfaceFromResource(resource)->commit();
+}
+
+void surfaceSetBufferTransform(wl_client*, wl_resource* resource, int32_t transform) {
+    if (transform != WL_OUTPUT_TRANSFORM_NORMAL) {
+        wl_resource_post_error(resource, WL_SURFACE_ERROR_INVALID_TRANSFORM, "only the normal transform is supported");
+    }
+}
+
+void surfaceSetBufferScale(wl_client*, wl_resource* resource, int32_t scale) {
+    if (scale < 1) {
+        wl_resource_post_error(resource, WL_SURFACE_ERROR_INVALID_SCALE, "scale %d", scale);
+        return;
+    }
+    surfaceFromResource(resource)->pending.scale = scale;
+}
+
+void surfaceDamageBuffer(wl_client*, wl_resource* resource, int32_t x, int32_t y, int32_t w, int32_t h) {
+    surfaceFromResource(resource)->pending.bufferDamage.add(x, y, w, h);
+}
+
+const struct wl_surface_interface kSurfaceImpl = {
+    surfaceDestroyRequest,
+    surfaceAttach,
+    surfaceDamage,
+    surfaceFrame,
+    surfaceSetRegion,
+    surfaceSetRegion,
+    surfaceCommit,
+    surfaceSetBufferTransform,
+    surfaceSetBufferScale,
+    surfaceDamageBuffer,
+    nullptr,                // offset (v5, not advertised)
+};
+
+void surfaceResourceDestroyed(wl_resource* resource) {
+    Surface* s = surfaceFromResource(resource);
+    s->unmap();
+    if (s->buffer) {
+        s->buffer->scanout = nullptr;
+        if (s->buffer->resource) wl_buffer_send_release(s->buffer->resource);
+        shmBufferUnref(s->buffer);
+    }
+    setPendingBuffer(s, nullptr);
+    wl_resource* cb;
+    wl_resource* next;
+    wl_resource_for_each_safe(cb, next, &s->pending.frames) wl_resource_destroy(cb);
+    if (s->xdg) s->xdg->surface = nullptr;
+    delete s;
+}
+
+void regionDestroyRequest(wl_client*, wl_resource* resource) {
+    wl_resource_destroy(resource);
+}
+
+void regionRect(wl_client*, wl_resource*, int32_t, int32_t, int32_t, int32_t) {}
+
+const struct wl_region_interface kRegionImpl = {
+    regionDestroyRequest,
+    regionRect,
+    regionRect,
+};
+
+void compositorCreateSurface(wl_client* client, wl_resource* resource, uint32_t id) {
+    auto* s = new Surface{};
+    s->owner = static_cast<Compositor*>(wl_resource_get_user_data(resource));
+    wl_list_init(&s->pending.frames);
+    s->pending.bufferWatch.listener.notify = pendingBufferDestroyed;
+    s->pending.bufferWatch.surface = s;
+    wl_list_init(&s->pending.bufferWatch.listener.link);
+    s->resource = wl_resource_create(client, &wl_surface_interface, wl_resource_get_version(resource), id);
+    if (!s->resource) {
+        delete s;
+        wl_resource_post_no_memory(resource);
+        return;
+    }
+    wl_resource_set_implementation(s->resource, &kSurfaceImpl, s, surfaceResourceDestroyed);
+}
+
+void compositorCreateRegion(wl_client* client, wl_resource* resource, uint32_t id) {
+    wl_resource* region = wl_resource_create(client, &wl_region_interface, 1, id);
+    if (!region) {
+        wl_resource_post_no_memory(resource);
+        return;
+    }
+    wl_resource_set_implementation(region, &kRegionImpl, nullptr, nullptr);
+}
+
+const struct wl_compositor_interface kCompositorImpl = {
+    compositorCreateSurface,
+    compositorCreateRegion,
+};
+
+void bindCompositor(wl_client* client, void* data, uint32_t version, uint32_t id) {
+    wl_resource* resource = wl_resource_create(client, &wl_compositor_interface, version, id);
+    if (!resource) {
+        wl_client_post_no_memory(client);
+        return;
+    }
+    wl_resource_set_implementation(resource, &kCompositorImpl, data, nullptr);
+}
+
+}
+
+Surface* surfaceFromResource(wl_resource* resource) {
+    return static_cast<Surface*>(wl_resource_get_user_data(resource));
+}
+
+// Double-buffered state becomes current. The buffer is bound to the layer in
+// place; what the engine recomposites is exactly the damage the client sent.
+void Surface::commit() {
+    owner->counters().commits++;
+
+    if (pending.attached) {
+        ShmBuffer* next = pending.buffer;
+        if (next != buffer) {
+            if (next) {
+                shmBufferRef(next);
+                next->scanout = this;
+            }
+            if (buffer) {
+                // The layer moves to the new pixels below, so the old buffer
+                // is free for the client as of this commit
+                buffer->scanout = nullptr;
+                if (buffer->resource) wl_buffer_send_release(buffer->resource);
+                shmBufferUnref(buffer);
+            }
+            buffer = next;
+        }
+    }
+    scale = pending.scale;
+
+    if (xdg) xdg->surfaceCommitted();
+
+    bool mappable = buffer && xdg && xdg->mappable();
+    if (!mappable) {
+        unmap();
+    } else {
+        bool fresh = layer < 0;
+        if (fresh && (layer = owner->acquireLayer(this)) >= 0) {
+            x = xdg->kind == XdgSurface::Popup ? xdg->popupX : 0;
+            y = xdg->kind == XdgSurface::Popup ? xdg->popupY : 0;
+            sys2d_set_layer_position(layer, x, y);
+            owner->counters().mappedSurfaces++;
+        }
+        if (layer >= 0 && (pending.attached || fresh)) {
+            // The old buffer is already released: a layer left on its pixels
+            // would show memory the client owns again
+            if (sys2d_layer_attach(layer, buffer->pixels(), buffer->stride / 4, buffer->width, buffer->height,
+                                   buffer->format == WL_SHM_FORMAT_XRGB8888 ? SYS2D_LAYER_OPAQUE : 0) != 0)
+                unmap();
+            else
+                owner->counters().attaches++;
+        }
+        if (layer >= 0) {
+
+            // Surface damage is in surface coordinates: scale it to buffer pixels
+            Rect d = pending.bufferDamage;
+            const Rect& sd = pending.damage;
+            if (!sd.empty()) {
+                int64_t x0 = static_cast<int64_t>(sd.x0) * scale, y0 = static_cast<int64_t>(sd.y0) * scale;
+                int64_t x1 = static_cast<int64_t>(sd.x1) * scale, y1 = static_cast<int64_t>(sd.y1) * scale;
+                auto c = [](int64_t v) { return static_cast<int32_t>(v < INT32_MIN ? INT32_MIN : (v > INT32_MAX ? INT32_MAX : v)); };
+                d.add(c(x0), c(y0), c(x1 - x0), c(y1 - y0));
+            }
+            d.clip(buffer->width, buffer->height);
+            if (!d.empty()) {
+                sys2d_layer_damage(layer, rect_t{d.x0, d.y0, d.x1 - d.x0, d.y1 - d.y0});
+                owner->counters().damagedPixels += static_cast<uint64_t>(d.x1 - d.x0) * (d.y1 - d.y0);
+            }
+        }
+    }
+
+    // Frame callbacks wait for the next present, whatever was committed
+    wl_list_insert_list(owner->frameList()->prev, &pending.frames);
+    wl_list_init(&pending.frames);
+
+    pending.attached = false;
+    setPendingBuffer(this, nullptr);
+    pending.damage = Rect{};
+    pending.bufferDamage = Rect{};
+}
+
+void Surface::rebind() {
+    if (layer < 0 || !buffer) return;
+    sys2d_layer_attach(layer, buffer->pixels(), buffer->stride / 4, buffer->width, buffer->height,
+                       buffer->format == WL_SHM_FORMAT_XRGB8888 ? SYS2D_LAYER_OPAQUE : 0);
+}
+
+void Surface::unmap() {
+    if (layer < 0) return;
+    sys2d_layer_detach(layer);
+    owner->releaseLayer(layer);
+    owner->counters().mappedSurfaces--;
+    layer = -1;
+}
+
+wl_global* createCompositorGlobal(wl_display* display, Compositor* owner) {
+    return wl_global_create(display, &wl_compositor_interface, 4, owner, bindCompositor);
+}
+
+}
@@ -0,0 +1,305 @@
+#include "wl_internal.hpp"
+// Generated: wayland-scanner server-header protocol/xdg-shell.xml xdg-shell-server-protocol.h
+//            wayland-scanner private-code protocol/xdg-shell.xml xdg-shell-protocol.c
+#include "xdg-shell-server-protocol.h"
+
+namespace palisade::gui::wayland {
+
+namespace {
+
+// Only what placement needs: popups go at anchor rect origin + offset
+struct Positioner {
+    int32_t width = 0, height = 0;
+    int32_t anchorX = 0, anchorY = 0;
+    int32_t offsetX = 0, offsetY = 0;
+};
+
+XdgSurface* xdgFromResource(wl_resource* resource) {
+    return static_cast<XdgSurface*>(wl_resource_get_user_data(resource));
+}
+
+void destroyRequest(wl_client*, wl_resource* resource) {
+    wl_resource_destroy(resource);
+}
+
+// ---- xdg_positioner ----
+
+Positioner* positionerFromResource(wl_resource* resource) {
+    return static_cast<Positioner*>(wl_resource_get_user_data(resource));
+}
+
+void positionerSetSize(wl_client*, wl_resource* resource, int32_t w, int32_t h) {
+    if (w < 1 || h < 1) {
+        wl_resource_post_error(resource, XDG_POSITIONER_ERROR_INVALID_INPUT, "size %dx%d", w, h);
+        return;
+    }
+    positionerFromResource(resource)->width = w;
+    positionerFromResource(resource)->height = h;
+}
+
+void positionerSetAnchorRect(wl_client*, wl_resource* resource, int32_t x, int32_t y, int32_t w, int32_t h) {
+    if (w < 0 || h < 0) {
+        wl_resource_post_error(resource, XDG_POSITIONER_ERROR_INVALID_INPUT, "anchor rect %dx%d", w, h);
+        return;
+    }
+    positionerFromResource(resource)->anchorX = x;
+    positionerFromResource(resource)->anchorY = y;
+}
+
+void positionerSetEnum(wl_client*, wl_resource*, uint32_t) {}
+
+void positionerSetOffset(wl_client*, wl_resource* resource, int32_t x, int32_t y) {
+    positionerFromResource(resource)->offsetX = x;
+    positionerFromResource(resource)->offsetY = y;
+}
+
+const struct xdg_positioner_interface kPositionerImpl = {
+    destroyRequest,
+    positionerSetSize,
+    positionerSetAnchorRect,
+    positionerSetEnum,          // set_anchor
+    positionerSetEnum,          // set_gravity
+    positionerSetEnum,          // set_constraint_adjustment
+    positionerSetOffset,
+};
+
+void positionerDestroyed(wl_resource* resource) {
+    delete positionerFromResource(resource);
+}
+
+// ---- xdg_toplevel / xdg_popup ----
+
+void sendConfigure(XdgSurface* xdg) {
+    wl_display* display = wl_client_get_display(wl_resource_get_client(xdg->resource));
+    xdg->serial = wl_display_next_serial(display);
+    xdg->configureSent = true;
+
+    if (xdg->kind == XdgSurface::Toplevel) {
+        // Phone shell: every toplevel gets the whole screen
+        const CompositorConfig& cfg = xdg->surface->owner->config();
+        wl_array states;
+        wl_array_init(&states);
+        uint32_t* s = static_cast<uint32_t*>(wl_array_add(&states, 2 * sizeof(uint32_t)));
+        if (s) {
+            s[0] = XDG_TOPLEVEL_STATE_MAXIMIZED;
+            s[1] = XDG_TOPLEVEL_STATE_ACTIVATED;
+        }
+        xdg_toplevel_send_configure(xdg->role, cfg.width, cfg.height, &states);
+        wl_array_release(&states);
+    } else {
+        xdg_popup_send_configure(xdg->role, xdg->popupX - xdg->parentX, xdg->popupY - xdg->parentY,
+                                 xdg->popupW, xdg->popupH);
+    }
+    xdg_surface_send_configure(xdg->resource, xdg->serial);
+}
+
+// The role object went away: back to a bare xdg_surface, unmapped
+void roleDestroyed(wl_resource* resource) {
+    XdgSurface* xdg = xdgFromResource(resource);
+    if (!xdg) return;   // xdg_surface went first
+    xdg->role = nullptr;
+    xdg->kind = XdgSurface::None;
+    xdg->configureSent = false;
+    xdg->configured = false;
+    xdg->mapped = false;
+    if (xdg->surface) xdg->surface->unmap();
+}
+
+void toplevelSetParent(wl_client*, wl_resource*, wl_resource*) {}
+void toplevelSetString(wl_client*, wl_resource*, const char*) {}
+void toplevelShowWindowMenu(wl_client*, wl_resource*, wl_resource*, uint32_t, int32_t, int32_t) {}
+void toplevelMove(wl_client*, wl_resource*, wl_resource*, uint32_t) {}
+void toplevelResize(wl_client*, wl_resource*, wl_resource*, uint32_t, uint32_t) {}
+void toplevelSetSize(wl_client*, wl_resource*, int32_t, int32_t) {}
+void toplevelSetState(wl_client*, wl_resource*) {}
+void toplevelSetFullscreen(wl_client*, wl_resource*, wl_resource*) {}
+
+// Window management requests are accepted and ignored: toplevels are always
+// maximized on this shell
+const struct xdg_toplevel_interface kToplevelImpl = {
+    destroyRequest,
+    toplevelSetParent,
+    toplevelSetString,          // set_title
+    toplevelSetString,          // set_app_id
+    toplevelShowWindowMenu,
+    toplevelMove,
+    toplevelResize,
+    toplevelSetSize,            // set_max_size
+    toplevelSetSize,            // set_min_size
+    toplevelSetState,           // set_maximized
+    toplevelSetState,           // unset_maximized
+    toplevelSetFullscreen,
+    toplevelSetState,           // unset_fullscreen
+    toplevelSetState,           // set_minimized
+};
+
+void popupGrab(wl_client*, wl_resource*, wl_resource*, uint32_t) {}
+
+const struct xdg_popup_interface kPopupImpl = {
+    destroyRequest,
+    popupGrab,
+};
+
+// ---- xdg_surface ----
+
+bool claimRole(XdgSurface* xdg, wl_resource* resource) {
+    if (xdg->kind != XdgSurface::None || xdg->role) {
+        wl_resource_post_error(resource, XDG_SURFACE_ERROR_ALREADY_CONSTRUCTED, "xdg_surface already has a role");
+        return false;
+    }
+    if (!xdg->surface) {
+        wl_resource_post_error(resource, XDG_SURFACE_ERROR_DEFUNCT_ROLE_OBJECT, "wl_surface is gone");
+        return false;
+    }
+    return true;
+}
+
+void xdgGetToplevel(wl_client* client, wl_resource* resource, uint32_t id) {
+    XdgSurface* xdg = xdgFromResource(resource);
+    if (!claimRole(xdg, resource)) return;
+    xdg->role = wl_resource_create(client, &xdg_toplevel_interface, wl_resource_get_version(resource), id);
+    if (!xdg->role) {
+        wl_resource_post_no_memory(resource);
+        return;
+    }
+    wl_resource_set_implementation(xdg->role, &kToplevelImpl, xdg, roleDestroyed);
+    xdg->kind = XdgSurface::Toplevel;
+}
+
+void xdgGetPopup(wl_client* client, wl_resource* resource, uint32_t id, wl_resource* parent, wl_resource* positioner) {
+    XdgSurface* xdg = xdgFromResource(resource);
+    if (!claimRole(xdg, resource)) return;
+    const Positioner* p = positionerFromResource(positioner);
+    if (p->width < 1 || p->height < 1) {
+        wl_resource_post_error(positioner, XDG_POSITIONER_ERROR_INVALID_INPUT, "positioner has no size");
+        return;
+    }
+    xdg->role = wl_resource_create(client, &xdg_popup_interface, wl_resource_get_version(resource), id);
+    if (!xdg->role) {
+        wl_resource_post_no_memory(resource);
+        return;
+    }
+    wl_resource_set_implementation(xdg->role, &kPopupImpl, xdg, roleDestroyed);
+    xdg->kind = XdgSurface::Popup;
+
+    // Placement is resolved now; the parent may go away before the popup
+    XdgSurface* px = parent ? xdgFromResource(parent) : nullptr;
+    xdg->parentX = px && px->surface ? px->surface->x : 0;
+    xdg->parentY = px && px->surface ? px->surface->y : 0;
+    xdg->popupX = xdg->parentX + p->anchorX + p->offsetX;
+    xdg->popupY = xdg->parentY + p->anchorY + p->offsetY;
+    xdg->popupW = p->width;
+    xdg->popupH = p->height;
+}
+
+void xdgSetWindowGeometry(wl_client*, wl_resource*, int32_t, int32_t, int32_t, int32_t) {}
+
+void xdgAckConfigure(wl_client*, wl_resource* resource, uint32_t serial) {
+    XdgSurface* xdg = xdgFromResource(resource);
+    if (!xdg->configureSent || serial != xdg->serial) {
+        wl_resource_post_error(resource, XDG_SURFACE_ERROR_INVALID_SERIAL, "unknown configure serial %u", serial);
+        return;
+    }
+    xdg->configured = true;
+}
+
+const struct xdg_surface_interface kXdgSurfaceImpl = {
+    destroyRequest,
+    xdgGetToplevel,
+    xdgGetPopup,
+    xdgSetWindowGeometry,
+    xdgAckConfigure,
+};
+
+void xdgSurfaceDestroyed(wl_resource* resource) {
+    XdgSurface* xdg = xdgFromResource(resource);
+    if (xdg->role) wl_resource_set_user_data(xdg->role, nullptr);
+    if (xdg->surface) {
+        xdg->surface->unmap();
+        xdg->surface->xdg = nullptr;
+    }
+    delete xdg;
+}
+
+// ---- xdg_wm_base ----
+
+void wmCreatePositioner(wl_client* client, wl_resource* resource, uint32_t id) {
+    wl_resource* r = wl_resource_create(client, &xdg_positioner_interface, wl_resource_get_version(resource), id);
+    if (!r) {
+        wl_resource_post_no_memory(resource);
+        return;
+    }
+    wl_resource_set_implementation(r, &kPositionerImpl, new Positioner{}, positionerDestroyed);
+}
+
+void wmGetXdgSurface(wl_client* client, wl_resource* resource, uint32_t id, wl_resource* surface) {
+    Surface* s = surfaceFromResource(surface);
+    if (s->xdg) {
+        wl_resource_post_error(resource, XDG_WM_BASE_ERROR_ROLE, "wl_surface already has an xdg_surface");
+        return;
+    }
+    if (s->buffer) {
+        wl_resource_post_error(resource, XDG_SURFACE_ERROR_UNCONFIGURED_BUFFER, "wl_surface already has a buffer");
+        return;
+    }
+    auto* xdg = new XdgSurface{};
+    xdg->surface = s;
+    xdg->resource = wl_resource_create(client, &xdg_surface_interface, wl_resource_get_version(resource), id);
+    if (!xdg->resource) {
+        delete xdg;
+        wl_resource_post_no_memory(resource);
+        return;
+    }
+    wl_resource_set_implementation(xdg->resource, &kXdgSurfaceImpl, xdg, xdgSurfaceDestroyed);
+    s->xdg = xdg;
+}
+
+void wmPong(wl_client*, wl_resource*, uint32_t) {}
+
+const struct xdg_wm_base_interface kWmBaseImpl = {
+    destroyRequest,
+    wmCreatePositioner,
+    wmGetXdgSurface,
+    wmPong,
+};
+
+void bindWmBase(wl_client* client, void*, uint32_t version, uint32_t id) {
+    wl_resource* resource = wl_resource_create(client, &xdg_wm_base_interface, version, id);
+    if (!resource) {
+        wl_client_post_no_memory(client);
+        return;
+    }
+    wl_resource_set_implementation(resource, &kWmBaseImpl, nullptr, nullptr);
+}
+
+}
+
+// Called from wl_surface.commit with the new state current
+void XdgSurface::surfaceCommitted() {
+    if (!surface->buffer) {
+        if (mapped) {
+            // A null buffer unmaps: the surface starts over as if the role
+            // were new, so its next initial commit gets a fresh configure
+            mapped = false;
+            configureSent = false;
+            configured = false;
+            return;
+        }
+        // Initial commit of a fresh role: the client now waits for a configure
+        if (kind != None && !configureSent) sendConfigure(this);
+        return;
+    }
+    if (kind == None) {
+        wl_resource_post_error(resource, XDG_SURFACE_ERROR_NOT_CONSTRUCTED, "buffer committed without a role");
+    } else if (!configured) {
+        wl_resource_post_error(resource, XDG_SURFACE_ERROR_UNCONFIGURED_BUFFER, "buffer committed before ack_configure");
+    } else {
+        mapped = true;
+    }
+}
+
+wl_global* createXdgShellGlobal(wl_display* display, Compositor* owner) {
+    return wl_global_create(display, &xdg_wm_base_interface, 1, owner, bindWmBase);
+}
+
+}
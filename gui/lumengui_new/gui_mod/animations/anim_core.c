@@ -0,0 +1,63 @@
+#include <animation.h>
+#include <gui_module.h>
+#include <sys2Dengine.h>
+
+struct anim_curve {
+    sys2d_ease_t ease;
+    float from, to;
+    int flags;
+};
+
+static const struct anim_curve anim_curves[ANIM_TYPE_COUNT] = {
+    [ANIM_FADE_IN]  = { SYS2D_EASE_LINEAR,  0.0f, 1.0f, 0 },
+    [ANIM_FADE_OUT] = { SYS2D_EASE_LINEAR,  1.0f, 0.0f, 0 },
+    [ANIM_SLIDE]    = { SYS2D_EASE_IN_QUAD, 0.0f, 1.0f, 0 },
+    [ANIM_SCALE]    = { SYS2D_EASE_LINEAR,  0.8f, 1.0f, 0 },
+    [ANIM_BOUNCE]   = { SYS2D_EASE_BOUNCE,  0.0f, 1.0f, 0 },
+    [ANIM_PULSE]    = { SYS2D_EASE_WAVE,    0.9f, 1.0f, SYS2D_ANIM_LOOP },
+};
+
+void anim_stop(struct animation *a) {
+    if (a->active)
+        sys2d_anim_cancel(a->handle);
+    a->handle = -1;
+    a->active = 0;
+}
+
+/* One unit of animation time lasts 1 / gui_anim_speed() seconds */
+void anim_start(struct animation *a, int type) {
+    if (type < 0 || type >= ANIM_TYPE_COUNT)
+        return;
+    const struct anim_curve *c = &anim_curves[type];
+    int fade = type == ANIM_FADE_IN || type == ANIM_FADE_OUT;
+    float *target = fade ? &a->alpha : &a->value;
+    float from = c->from;
+
+    /* A fade-out interrupting a fade-in starts where the alpha is */
+    if (type == ANIM_FADE_OUT && a->active && a->type == ANIM_FADE_IN)
+        from = a->alpha;
+
+    anim_stop(a);
+    a->type = type;
+    a->time = 0;
+    a->handle = sys2d_animate_value(target, from, c->to,
+                                    (uint32_t)(1000.0f / gui_anim_speed()),
+                                    c->ease, c->flags);
+    a->active = a->handle >= 0;
+    if (!a->active)
+        *target = c->to;
+}
+
+void anim_update(struct animation *a) {
+    if (!a->active)
+        return;
+
+    float t = sys2d_anim_progress(a->handle);
+    if (t < 0) {
+        a->time = 1.0f;
+        a->active = 0;
+        a->handle = -1;
+        return;
+    }
+    a->time = t;
+}
@@ -0,0 +1,6 @@
+#include <animation.h>
+#include <math.h>
+
+float anim_pulse(float t) {
+    return 0.9f + 0.1f * sinf(t * 6.28f);
+}
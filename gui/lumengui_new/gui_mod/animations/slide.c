@@ -0,0 +1,5 @@
+#include <animation.h>
+
+float anim_slide(float t) {
+    return t * t;
+}
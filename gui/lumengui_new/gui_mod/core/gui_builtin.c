@@ -0,0 +1,28 @@
+#include <gui_module.h>
+#include <overlay.h>
+#include <sensors.h>
+#include <stddef.h>
+
+#define MS(n) ((uint64_t)(n) * 1000000ULL)
+
+/*
+ * The FPS overlay counts frames, so it is the one per-frame module. The
+ * network counters are shown in KiB, so a second is fine unless the link
+ * state changes. Monitors are pushed by the sensor hub; their updates are
+ * slow polls that only matter if a notification was missed.
+ */
+static const struct gui_module_desc builtin_modules[] = {
+    { "fps_overlay", NULL, fps_overlay_update, 0, 0, 0 },
+    { "network_overlay", NULL, network_overlay_update, MS(1000), GUI_EVENT_BIT(GUI_EVENT_NETWORK), 0 },
+    { "battery_monitor", battery_monitor_init, battery_monitor_update, MS(30000), 0, 0 },
+    { "thermal_monitor", thermal_monitor_init, thermal_monitor_update, MS(5000), 0, 0 },
+};
+
+int gui_register_builtin_modules(void) {
+    int n = (int)(sizeof(builtin_modules) / sizeof(builtin_modules[0]));
+    for (int i = 0; i < n; i++) {
+        if (gui_register_module_ex(&builtin_modules[i]) != 0)
+            return -1;
+    }
+    return 0;
+}
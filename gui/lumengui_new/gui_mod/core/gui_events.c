@@ -0,0 +1,317 @@
+#define _POSIX_C_SOURCE 200809L
+#include <gui_module.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+#define QUEUE_MASK (GUI_EVENT_QUEUE_SIZE - 1)
+#define CACHE_LINE 64
+
+/*
+ * Bounded MPMC ring (Vyukov): each cell carries a sequence number, so a
+ * producer or consumer claims a cell with one CAS on the shared position
+ * and then owns it exclusively. Full and empty are detected, never
+ * overwritten.
+ */
+struct event_cell {
+    _Atomic size_t seq;
+    struct gui_event ev;
+};
+
+static struct event_cell queue[GUI_EVENT_QUEUE_SIZE];
+static _Alignas(CACHE_LINE) _Atomic size_t enqueue_pos;
+static _Alignas(CACHE_LINE) _Atomic size_t dequeue_pos;
+static atomic_flag queue_ready = ATOMIC_FLAG_INIT;
+static _Atomic int queue_initialized;
+
+/*
+ * Coalescing slot per state type: a seqlock (odd = writer inside, which
+ * also serialises writers) over the latest payload. delivered is the seq of
+ * the last value handed out; a consumer claims a newer one by moving it with
+ * a CAS, so every written value reaches at most one consumer, at most once.
+ */
+struct state_slot {
+    _Alignas(CACHE_LINE) _Atomic uint32_t seq;
+    _Atomic uint32_t delivered;
+    _Atomic uint64_t payload;
+    _Atomic uint64_t time_ns;
+};
+
+static struct state_slot states[GUI_EVENT_STATE_LAST + 1];
+
+static _Atomic uint64_t stat_pushed, stat_popped, stat_coalesced, stat_overflow;
+static _Atomic uint64_t stat_latency_sum, stat_latency_max;
+static _Atomic uint64_t fired_types;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int is_state_type(int type) {
+    return type > GUI_EVENT_NONE && type <= GUI_EVENT_STATE_LAST;
+}
+
+/* Cell sequences start at their index; the first caller sets them up */
+static void queue_init(void) {
+    if (atomic_load_explicit(&queue_initialized, memory_order_acquire))
+        return;
+    if (!atomic_flag_test_and_set_explicit(&queue_ready, memory_order_acq_rel)) {
+        for (size_t i = 0; i < GUI_EVENT_QUEUE_SIZE; i++)
+            atomic_store_explicit(&queue[i].seq, i, memory_order_relaxed);
+        atomic_store_explicit(&queue_initialized, 1, memory_order_release);
+    }
+    while (!atomic_load_explicit(&queue_initialized, memory_order_acquire))
+        sched_yield();
+}
+
+static int queue_push(const struct gui_event *ev) {
+    size_t pos = atomic_load_explicit(&enqueue_pos, memory_order_relaxed);
+    for (;;) {
+        struct event_cell *c = &queue[pos & QUEUE_MASK];
+        size_t seq = atomic_load_explicit(&c->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                c->ev = *ev;
+                atomic_store_explicit(&c->seq, pos + 1, memory_order_release);
+                return 0;
+            }
+        } else if (diff < 0) {
+            return -1;      /* Full */
+        } else {
+            pos = atomic_load_explicit(&enqueue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+static int queue_pop(struct gui_event *out) {
+    size_t pos = atomic_load_explicit(&dequeue_pos, memory_order_relaxed);
+    for (;;) {
+        struct event_cell *c = &queue[pos & QUEUE_MASK];
+        size_t seq = atomic_load_explicit(&c->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&dequeue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                *out = c->ev;
+                atomic_store_explicit(&c->seq, pos + GUI_EVENT_QUEUE_SIZE, memory_order_release);
+                return 1;
+            }
+        } else if (diff < 0) {
+            return 0;       /* Empty */
+        } else {
+            pos = atomic_load_explicit(&dequeue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+static void state_write(const struct gui_event *ev) {
+    struct state_slot *s = &states[ev->type];
+    uint32_t seq = atomic_load_explicit(&s->seq, memory_order_relaxed);
+    for (;;) {
+        if (!(seq & 1) && atomic_compare_exchange_weak_explicit(&s->seq, &seq, seq + 1,
+                                                                memory_order_acquire, memory_order_relaxed))
+            break;
+        if (seq & 1) {
+            sched_yield();
+            seq = atomic_load_explicit(&s->seq, memory_order_relaxed);
+        }
+    }
+    /*
+     * Seq is odd, then the payload is stored with release: a reader whose
+     * acquire load sees any new payload also sees the odd seq on its
+     * re-check, and its acquire payload loads keep that re-check below
+     * them. Fences would do as well, but race detectors do not model them.
+     */
+    atomic_store_explicit(&s->payload, ev->u64, memory_order_release);
+    atomic_store_explicit(&s->time_ns, ev->time_ns, memory_order_release);
+    atomic_store_explicit(&s->seq, seq + 2, memory_order_release);
+
+    /* The value replaced here was never delivered */
+    if (atomic_load_explicit(&s->delivered, memory_order_relaxed) != seq)
+        atomic_fetch_add_explicit(&stat_coalesced, 1, memory_order_relaxed);
+}
+
+static int state_read(int type, struct gui_event *out) {
+    struct state_slot *s = &states[type];
+    uint32_t seen, before, after;
+    do {
+        seen = atomic_load_explicit(&s->delivered, memory_order_acquire);
+        if (atomic_load_explicit(&s->seq, memory_order_relaxed) == seen)
+            return 0;
+        do {
+            before = atomic_load_explicit(&s->seq, memory_order_acquire);
+            out->u64 = atomic_load_explicit(&s->payload, memory_order_acquire);
+            out->time_ns = atomic_load_explicit(&s->time_ns, memory_order_acquire);
+            after = atomic_load_explicit(&s->seq, memory_order_relaxed);
+        } while ((before & 1) || before != after);
+        /* Losing means another consumer delivered something; look again */
+    } while (!atomic_compare_exchange_strong_explicit(&s->delivered, &seen, before,
+                                                       memory_order_acq_rel, memory_order_acquire));
+    out->type = type;
+    out->flags = 0;
+    return 1;
+}
+
+static void record_latency(const struct gui_event *ev, uint64_t now) {
+    uint64_t lat = now > ev->time_ns ? now - ev->time_ns : 0;
+    atomic_fetch_add_explicit(&stat_latency_sum, lat, memory_order_relaxed);
+    uint64_t max = atomic_load_explicit(&stat_latency_max, memory_order_relaxed);
+    while (lat > max && !atomic_compare_exchange_weak_explicit(&stat_latency_max, &max, lat,
+                                                               memory_order_relaxed, memory_order_relaxed))
+        ;
+}
+
+int gui_event_post(const struct gui_event *ev) {
+    if (ev->type <= GUI_EVENT_NONE || ev->type >= GUI_EVENT_MAX)
+        return -1;
+    struct gui_event e = *ev;
+    e.time_ns = now_ns();
+
+    if (is_state_type(e.type)) {
+        state_write(&e);
+    } else {
+        queue_init();
+        if (queue_push(&e) != 0) {
+            atomic_fetch_add_explicit(&stat_overflow, 1, memory_order_relaxed);
+            return -1;
+        }
+    }
+    atomic_fetch_add_explicit(&stat_pushed, 1, memory_order_relaxed);
+
+    /* Read first: a set bit costs producers no write to the shared line */
+    uint64_t bit = 1ULL << e.type;
+    if (!(atomic_load_explicit(&fired_types, memory_order_relaxed) & bit))
+        atomic_fetch_or_explicit(&fired_types, bit, memory_order_release);
+    return 0;
+}
+
+uint64_t gui_event_take_fired(void) {
+    if (!atomic_load_explicit(&fired_types, memory_order_relaxed))
+        return 0;
+    return atomic_exchange_explicit(&fired_types, 0, memory_order_acquire);
+}
+
+int gui_event_push(int type, int value) {
+    struct gui_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.type = type;
+    ev.value = value;
+    return gui_event_post(&ev);
+}
+
+int gui_event_pop_batch(struct gui_event *out, int max) {
+    int n = 0;
+    for (int t = GUI_EVENT_NONE + 1; t <= GUI_EVENT_STATE_LAST && n < max; t++)
+        n += state_read(t, &out[n]);
+
+    queue_init();
+    while (n < max && queue_pop(&out[n]))
+        n++;
+
+    if (n) {
+        uint64_t now = now_ns();
+        for (int i = 0; i < n; i++)
+            record_latency(&out[i], now);
+        atomic_fetch_add_explicit(&stat_popped, (uint64_t)n, memory_order_relaxed);
+    }
+    return n;
+}
+
+int gui_event_pop(struct gui_event *out) {
+    return gui_event_pop_batch(out, 1);
+}
+
+void gui_event_get_stats(struct gui_event_stats *out) {
+    out->pushed = atomic_load_explicit(&stat_pushed, memory_order_relaxed);
+    out->popped = atomic_load_explicit(&stat_popped, memory_order_relaxed);
+    out->coalesced = atomic_load_explicit(&stat_coalesced, memory_order_relaxed);
+    out->overflow = atomic_load_explicit(&stat_overflow, memory_order_relaxed);
+    out->latency_sum_ns = atomic_load_explicit(&stat_latency_sum, memory_order_relaxed);
+    out->latency_max_ns = atomic_load_explicit(&stat_latency_max, memory_order_relaxed);
+}
+
+/* ---- Benchmark ---- */
+
+struct bench_ctx {
+    int events;
+    int id;
+    _Atomic int *producers_left;
+    _Atomic uint64_t *consumed;
+};
+
+/* One in 16 posts is a battery/thermal update, the rest are touches */
+static void *bench_producer(void *arg) {
+    struct bench_ctx *ctx = arg;
+    struct gui_event ev;
+    memset(&ev, 0, sizeof(ev));
+    for (int i = 0; i < ctx->events; i++) {
+        if ((i & 15) == 0) {
+            ev.type = (i & 16) ? GUI_EVENT_THERMAL : GUI_EVENT_BATTERY;
+            ev.value = i % 100;
+        } else {
+            ev.type = GUI_EVENT_TOUCH;
+            ev.point.x = (float)(i % 1440);
+            ev.point.y = (float)ctx->id;
+        }
+        while (gui_event_post(&ev) != 0)
+            sched_yield();      /* Backpressure: the bench must not lose events */
+    }
+    atomic_fetch_sub_explicit(ctx->producers_left, 1, memory_order_release);
+    return NULL;
+}
+
+static void *bench_consumer(void *arg) {
+    struct bench_ctx *ctx = arg;
+    struct gui_event batch[64];
+    for (;;) {
+        int n = gui_event_pop_batch(batch, 64);
+        if (n) {
+            atomic_fetch_add_explicit(ctx->consumed, (uint64_t)n, memory_order_relaxed);
+        } else if (!atomic_load_explicit(ctx->producers_left, memory_order_acquire)) {
+            if (!gui_event_pop_batch(batch, 64))
+                break;
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+struct gui_event_bench_result gui_event_bench(int producers, int consumers, int events_per_producer) {
+    struct gui_event_bench_result r;
+    memset(&r, 0, sizeof(r));
+    if (producers < 1 || consumers < 1 || producers > 32 || consumers > 32)
+        return r;
+
+    pthread_t threads[64];
+    struct bench_ctx ctx[64];
+    _Atomic int left = producers;
+    _Atomic uint64_t consumed = 0;
+    struct gui_event_stats before, after;
+    gui_event_get_stats(&before);
+
+    uint64_t start = now_ns();
+    for (int i = 0; i < producers + consumers; i++) {
+        ctx[i] = (struct bench_ctx){events_per_producer, i, &left, &consumed};
+        pthread_create(&threads[i], NULL, i < producers ? bench_producer : bench_consumer, &ctx[i]);
+    }
+    for (int i = 0; i < producers + consumers; i++)
+        pthread_join(threads[i], NULL);
+    uint64_t elapsed = now_ns() - start;
+
+    gui_event_get_stats(&after);
+    uint64_t posted = after.pushed - before.pushed;
+    r.events = posted;
+    r.events_per_sec = elapsed ? posted * 1e9 / elapsed : 0.0;
+    uint64_t popped = after.popped - before.popped;
+    r.avg_latency_us = popped ? (after.latency_sum_ns - before.latency_sum_ns) / 1e3 / popped : 0.0;
+    r.overflow = after.overflow - before.overflow;
+    return r;
+}
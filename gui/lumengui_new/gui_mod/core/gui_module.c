@@ -0,0 +1,186 @@
+#define _POSIX_C_SOURCE 200809L
+#include <gui_module.h>
+#include <string.h>
+#include <time.h>
+
+static struct gui_module modules[GUI_MAX_MODULES];
+static int module_count = 0;
+
+/* Periodic modules: min-heap of indices by next_due_ns */
+static int heap[GUI_MAX_MODULES];
+static int heap_size = 0;
+
+static uint32_t every_frame;                    /* Bit per module */
+static uint32_t subscribers[GUI_EVENT_MAX];     /* Per event type */
+
+static void (*slow_handler)(const struct gui_module_stats *st, uint64_t run_ns);
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int due_before(int a, int b) {
+    return modules[heap[a]].next_due_ns < modules[heap[b]].next_due_ns;
+}
+
+static void heap_swap(int a, int b) {
+    int t = heap[a];
+    heap[a] = heap[b];
+    heap[b] = t;
+}
+
+static void heap_push(int index) {
+    int i = heap_size++;
+    heap[i] = index;
+    while (i > 0 && due_before(i, (i - 1) / 2)) {
+        heap_swap(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+static void heap_sift_down(int i) {
+    for (;;) {
+        int l = 2 * i + 1, r = l + 1, m = i;
+        if (l < heap_size && due_before(l, m)) m = l;
+        if (r < heap_size && due_before(r, m)) m = r;
+        if (m == i)
+            return;
+        heap_swap(i, m);
+        i = m;
+    }
+}
+
+int gui_register_module_ex(const struct gui_module_desc *desc) {
+    if (module_count >= GUI_MAX_MODULES || !desc->update)
+        return -1;
+
+    int index = module_count++;
+    struct gui_module *m = &modules[index];
+    memset(m, 0, sizeof(*m));
+    m->desc = *desc;
+    if (!m->desc.budget_ns)
+        m->desc.budget_ns = GUI_MODULE_DEFAULT_BUDGET;
+    m->stats.name = desc->name;
+    m->stats.budget_ns = m->desc.budget_ns;
+
+    if (desc->period_ns) {
+        m->next_due_ns = now_ns() + desc->period_ns;
+        heap_push(index);
+    }
+    for (int t = 0; t < GUI_EVENT_MAX; t++) {
+        if (desc->events & (1ULL << t))
+            subscribers[t] |= 1u << index;
+    }
+    if (!desc->period_ns && !desc->events)
+        every_frame |= 1u << index;
+    return 0;
+}
+
+/* Legacy registration: every frame */
+int gui_register_module(const char *name,
+                        void (*init)(void),
+                        void (*update)(void)) {
+    struct gui_module_desc d;
+    memset(&d, 0, sizeof(d));
+    d.name = name;
+    d.init = init;
+    d.update = update;
+    return gui_register_module_ex(&d);
+}
+
+void gui_init_all(void) {
+    for (int i = 0; i < module_count; i++) {
+        if (modules[i].desc.init)
+            modules[i].desc.init();
+    }
+}
+
+static void run_module(int index) {
+    struct gui_module *m = &modules[index];
+    uint64_t t0 = now_ns();
+    m->desc.update();
+    uint64_t ns = now_ns() - t0;
+
+    m->stats.runs++;
+    m->stats.total_ns += ns;
+    if (ns > m->stats.max_ns)
+        m->stats.max_ns = ns;
+    if (ns > m->desc.budget_ns) {
+        m->stats.over_budget++;
+        if (slow_handler)
+            slow_handler(&m->stats, ns);
+    }
+}
+
+/*
+ * Collects due modules into one mask (a module due for several reasons runs
+ * once), then runs them in registration order. Periodic modules are
+ * rescheduled from their previous due time; after a stall they resume one
+ * period from now instead of catching up.
+ */
+void gui_update_due(uint64_t now) {
+    uint32_t due = every_frame;
+
+    uint64_t fired = gui_event_take_fired();
+    while (fired) {
+        int t = __builtin_ctzll(fired);
+        fired &= fired - 1;
+        if (t < GUI_EVENT_MAX)
+            due |= subscribers[t];
+    }
+
+    while (heap_size && modules[heap[0]].next_due_ns <= now) {
+        struct gui_module *m = &modules[heap[0]];
+        due |= 1u << heap[0];
+        m->next_due_ns += m->desc.period_ns;
+        if (m->next_due_ns <= now)
+            m->next_due_ns = now + m->desc.period_ns;
+        heap_sift_down(0);
+    }
+
+    while (due) {
+        int i = __builtin_ctz(due);
+        due &= due - 1;
+        run_module(i);
+    }
+}
+
+void gui_update_all(void) {
+    gui_update_due(now_ns());
+}
+
+void gui_module_on_slow(void (*handler)(const struct gui_module_stats *st, uint64_t run_ns)) {
+    slow_handler = handler;
+}
+
+int gui_module_count(void) {
+    return module_count;
+}
+
+int gui_module_get_stats(int index, struct gui_module_stats *out) {
+    if (index < 0 || index >= module_count)
+        return -1;
+    *out = modules[index].stats;
+    return 0;
+}
+
+int gui_module_report_slow(struct gui_module_stats *out, int max) {
+    struct gui_module_stats slow[GUI_MAX_MODULES];
+    int n = 0;
+    for (int i = 0; i < module_count; i++) {
+        if (!modules[i].stats.over_budget)
+            continue;
+        int j = n++;
+        while (j > 0 && slow[j - 1].over_budget < modules[i].stats.over_budget) {
+            slow[j] = slow[j - 1];
+            j--;
+        }
+        slow[j] = modules[i].stats;
+    }
+    if (n > max)
+        n = max;
+    memcpy(out, slow, (size_t)(n > 0 ? n : 0) * sizeof(*out));
+    return n;
+}
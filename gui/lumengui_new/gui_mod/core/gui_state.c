@@ -0,0 +1,19 @@
+#include <gui_module.h>
+#include <settings.h>
+#include <stddef.h>
+
+/* Preferences live in the settings store; these are gui_mod's views of them */
+void gui_state_init(void) {
+    settings_open(NULL);
+}
+
+void gui_set_low_power(int on) {
+    setting_set_i(SETTING_LOW_POWER, on != 0);
+}
+
+/* Low power runs animations at 1x without touching the user's speed */
+float gui_anim_speed(void) {
+    if (setting_get_i(SETTING_LOW_POWER))
+        return 1.0f;
+    return setting_get_f(SETTING_ANIM_SPEED);
+}
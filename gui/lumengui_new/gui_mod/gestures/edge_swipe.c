@@ -0,0 +1,49 @@
+#include <gesture.h>
+
+#define EDGE_MARGIN_PX      16.0f
+#define EDGE_TRAVEL_PX      30.0f
+#define SWIPE_MIN_PX        48.0f
+#define SWIPE_MAX_NS        500000000ULL
+
+/* Edge swipe: lands on the left edge and travels right -> back */
+static int edge_swipe_event(struct gesture_recognizer *r, const struct gesture_input *in,
+                            const struct gesture_touches *t) {
+    (void)r;
+    if (t->max_count > 1 || t->pt[in->finger].x0 >= EDGE_MARGIN_PX || in->type == GESTURE_IN_UP)
+        return GESTURE_FAILED;
+    if (t->pt[in->finger].x - t->pt[in->finger].x0 > EDGE_TRAVEL_PX)
+        return GESTURE_RECOGNIZED;
+    return GESTURE_POSSIBLE;
+}
+
+struct gesture_recognizer edge_swipe_recognizer = {
+    .name = "edge_swipe",
+    .on_event = edge_swipe_event,
+    .gesture = GESTURE_BACK,
+};
+
+/* Swipe: one finger, fast travel; direction picks the gesture */
+static int swipe_event(struct gesture_recognizer *r, const struct gesture_input *in,
+                       const struct gesture_touches *t) {
+    if (t->max_count > 1 || in->type == GESTURE_IN_UP)
+        return GESTURE_FAILED;
+    if (in->time_ns - t->start_ns > SWIPE_MAX_NS)
+        return GESTURE_FAILED;  /* Too slow: that's a drag */
+
+    float dx = t->pt[in->finger].x - t->pt[in->finger].x0;
+    float dy = t->pt[in->finger].y - t->pt[in->finger].y0;
+    if (dx * dx + dy * dy < SWIPE_MIN_PX * SWIPE_MIN_PX)
+        return GESTURE_POSSIBLE;
+
+    if ((dx < 0 ? -dx : dx) > (dy < 0 ? -dy : dy))
+        r->gesture = dx < 0 ? GESTURE_SWIPE_LEFT : GESTURE_SWIPE_RIGHT;
+    else
+        r->gesture = dy < 0 ? GESTURE_SWIPE_UP : GESTURE_SWIPE_DOWN;
+    return GESTURE_RECOGNIZED;
+}
+
+struct gesture_recognizer swipe_recognizer = {
+    .name = "swipe",
+    .on_event = swipe_event,
+    .gesture = GESTURE_SWIPE_RIGHT,
+};
@@ -0,0 +1,52 @@
+#include <gesture.h>
+
+#define TOUCH_SLOP_PX       12.0f
+#define TAP_MAX_NS          300000000ULL
+#define LONG_PRESS_NS       600000000ULL
+
+static int moved_past_slop(const struct gesture_touches *t, int finger) {
+    float dx = t->pt[finger].x - t->pt[finger].x0;
+    float dy = t->pt[finger].y - t->pt[finger].y0;
+    return dx * dx + dy * dy > TOUCH_SLOP_PX * TOUCH_SLOP_PX;
+}
+
+/* Tap: one finger, down and up quickly without moving */
+static int tap_event(struct gesture_recognizer *r, const struct gesture_input *in,
+                     const struct gesture_touches *t) {
+    (void)r;
+    if (t->max_count > 1 || moved_past_slop(t, in->finger))
+        return GESTURE_FAILED;
+    if (in->type == GESTURE_IN_UP)
+        return in->time_ns - t->start_ns <= TAP_MAX_NS ? GESTURE_RECOGNIZED : GESTURE_FAILED;
+    return GESTURE_POSSIBLE;
+}
+
+struct gesture_recognizer tap_recognizer = {
+    .name = "tap",
+    .on_event = tap_event,
+    .gesture = GESTURE_TAP,
+};
+
+/* Long press: one finger held still; fires from a timer, not a per-frame counter */
+static int long_press_event(struct gesture_recognizer *r, const struct gesture_input *in,
+                            const struct gesture_touches *t) {
+    if (in->type == GESTURE_IN_DOWN && t->count == 1)
+        r->deadline_ns = in->time_ns + LONG_PRESS_NS;
+    if (t->max_count > 1 || in->type == GESTURE_IN_UP || moved_past_slop(t, in->finger))
+        return GESTURE_FAILED;
+    return GESTURE_POSSIBLE;
+}
+
+static int long_press_deadline(struct gesture_recognizer *r, uint64_t now_ns,
+                               const struct gesture_touches *t) {
+    (void)r;
+    (void)now_ns;
+    return t->count == 1 ? GESTURE_RECOGNIZED : GESTURE_FAILED;
+}
+
+struct gesture_recognizer long_press_recognizer = {
+    .name = "long_press",
+    .on_event = long_press_event,
+    .on_deadline = long_press_deadline,
+    .gesture = GESTURE_LONG_PRESS,
+};
@@ -0,0 +1,61 @@
+#include <gesture.h>
+
+#define PINCH_MIN_PX        24.0f
+#define THREE_FINGER_NS     150000000ULL  /* All three must land within this */
+
+static int first_two(const struct gesture_touches *t, int *a, int *b) {
+    int n = 0;
+    for (int i = 0; i < GESTURE_MAX_POINTS && n < 2; i++) {
+        if (!t->pt[i].down)
+            continue;
+        if (n++ == 0) *a = i;
+        else *b = i;
+    }
+    return n == 2;
+}
+
+static float span(float ax, float ay, float bx, float by) {
+    float dx = ax - bx, dy = ay - by;
+    return __builtin_sqrtf(dx * dx + dy * dy);
+}
+
+/* Pinch: exactly two fingers whose distance changes past the threshold */
+static int pinch_event(struct gesture_recognizer *r, const struct gesture_input *in,
+                       const struct gesture_touches *t) {
+    int a, b;
+    if (t->max_count > 2 || (in->type == GESTURE_IN_UP && t->count == 0))
+        return GESTURE_FAILED;
+    if (t->count != 2 || !first_two(t, &a, &b))
+        return GESTURE_POSSIBLE;
+
+    float d = span(t->pt[a].x, t->pt[a].y, t->pt[b].x, t->pt[b].y);
+    if (in->type == GESTURE_IN_DOWN) {
+        r->f[0] = d;  /* Reference span when the second finger lands */
+        return GESTURE_POSSIBLE;
+    }
+    float delta = d - r->f[0];
+    return (delta < 0 ? -delta : delta) > PINCH_MIN_PX ? GESTURE_RECOGNIZED : GESTURE_POSSIBLE;
+}
+
+struct gesture_recognizer pinch_recognizer = {
+    .name = "pinch",
+    .on_event = pinch_event,
+    .gesture = GESTURE_PINCH,
+};
+
+/* Three finger: a third finger lands shortly after the first */
+static int three_finger_event(struct gesture_recognizer *r, const struct gesture_input *in,
+                              const struct gesture_touches *t) {
+    (void)r;
+    if (in->type == GESTURE_IN_UP && t->max_count < 3)
+        return GESTURE_FAILED;
+    if (in->type == GESTURE_IN_DOWN && t->count == 3)
+        return in->time_ns - t->start_ns <= THREE_FINGER_NS ? GESTURE_RECOGNIZED : GESTURE_FAILED;
+    return GESTURE_POSSIBLE;
+}
+
+struct gesture_recognizer three_finger_recognizer = {
+    .name = "three_finger",
+    .on_event = three_finger_event,
+    .gesture = GESTURE_THREE_FINGER,
+};
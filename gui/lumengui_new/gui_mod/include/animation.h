@@ -0,0 +1,51 @@
+#ifndef GUI_ANIMATION_H
+#define GUI_ANIMATION_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum anim_type {
+    ANIM_FADE_IN = 0,       /* alpha 0 -> 1 */
+    ANIM_FADE_OUT,          /* alpha current -> 0 */
+    ANIM_SLIDE,             /* value 0 -> 1, ease-in */
+    ANIM_SCALE,             /* value 0.8 -> 1 */
+    ANIM_BOUNCE,            /* value settles at 1 */
+    ANIM_PULSE,             /* value 0.8 .. 1.0, loops */
+    ANIM_TYPE_COUNT
+};
+
+/*
+ * Handle into the engine's animation store. Values are advanced in the
+ * engine's per-frame batch and written straight into alpha/value, so the
+ * struct must stay alive (or be anim_stop()ed) while the animation runs.
+ */
+struct animation {
+    int type;
+    int handle;             /* -1 when idle */
+    int active;
+    float time;             /* Progress 0..1 */
+    float alpha;
+    float value;
+};
+
+void anim_start(struct animation *a, int type);
+void anim_update(struct animation *a);      /* Syncs time/active, no stepping */
+void anim_stop(struct animation *a);
+
+/* Scalar curves for one-off evaluation; the engine batch uses the same shapes */
+float anim_bounce(float t);
+float anim_fade(float t);
+float anim_pulse(float t);
+float anim_scale(float t);
+float anim_slide(float t);
+
+float gui_anim_speed(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
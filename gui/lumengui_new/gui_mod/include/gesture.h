@@ -0,0 +1,98 @@
+#ifndef GUI_GESTURE_H
+#define GUI_GESTURE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum gesture_type {
+    GESTURE_NONE = 0,
+    GESTURE_TAP,
+    GESTURE_LONG_PRESS,
+    GESTURE_SWIPE_LEFT,
+    GESTURE_SWIPE_RIGHT,
+    GESTURE_SWIPE_UP,
+    GESTURE_SWIPE_DOWN,
+    GESTURE_BACK,           /* Edge swipe from the left edge */
+    GESTURE_PINCH,
+    GESTURE_THREE_FINGER,
+};
+
+/* Raw input stream fed to the engine (one call per touch event) */
+enum gesture_input_type {
+    GESTURE_IN_DOWN,
+    GESTURE_IN_MOVE,
+    GESTURE_IN_UP,
+    GESTURE_IN_CANCEL,
+};
+
+struct gesture_input {
+    int type;
+    int finger;             /* 0 .. GESTURE_MAX_POINTS-1 */
+    float x, y;
+    uint64_t time_ns;
+};
+
+#define GESTURE_MAX_POINTS      10
+#define GESTURE_MAX_RECOGNIZERS 16
+
+/* Contacts of the current sequence (first down .. last up), kept by the engine */
+struct gesture_touches {
+    int count;              /* Fingers currently down */
+    int max_count;          /* Most fingers down at once this sequence */
+    uint64_t start_ns;
+    struct {
+        int down;
+        float x0, y0;       /* Where the finger landed */
+        float x, y;
+        uint64_t t0;
+    } pt[GESTURE_MAX_POINTS];
+};
+
+/* Recognizer states (discrete gestures go POSSIBLE -> RECOGNIZED or FAILED) */
+enum gesture_state {
+    GESTURE_POSSIBLE = 0,
+    GESTURE_RECOGNIZED,
+    GESTURE_FAILED,
+};
+
+struct gesture_recognizer {
+    const char *name;
+    /* Called for every event while POSSIBLE; returns the new state */
+    int (*on_event)(struct gesture_recognizer *r, const struct gesture_input *in,
+                    const struct gesture_touches *t);
+    /* Called once deadline_ns passes (timers instead of per-frame polling) */
+    int (*on_deadline)(struct gesture_recognizer *r, uint64_t now_ns,
+                       const struct gesture_touches *t);
+    void (*reset)(struct gesture_recognizer *r);
+
+    int state;
+    int gesture;            /* What to emit when recognized */
+    uint64_t deadline_ns;   /* 0 = no timer armed */
+    float f[4];             /* Per-recognizer scratch */
+};
+
+/* Built-in recognizers (gui_mod/gestures) */
+extern struct gesture_recognizer tap_recognizer;
+extern struct gesture_recognizer long_press_recognizer;
+extern struct gesture_recognizer edge_swipe_recognizer;
+extern struct gesture_recognizer swipe_recognizer;
+extern struct gesture_recognizer pinch_recognizer;
+extern struct gesture_recognizer three_finger_recognizer;
+
+/* Engine (input/methods/gesture/gesture_engine.cpp) */
+void gesture_engine_init(void);
+int gesture_engine_register(struct gesture_recognizer *r);  /* Earlier = higher priority */
+void gesture_engine_feed(const struct gesture_input *in);
+uint64_t gesture_engine_next_deadline(void);                /* 0 = nothing pending */
+void gesture_engine_tick(uint64_t now_ns);
+
+void emit_gesture(int gesture);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
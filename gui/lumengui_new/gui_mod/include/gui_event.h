@@ -0,0 +1,83 @@
+#ifndef GUI_EVENT_H
+#define GUI_EVENT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Event types. State-style types (battery, thermal, ...) coalesce: a push
+ * replaces the undelivered value instead of taking a queue slot, so a
+ * consumer sees the latest state once. All others are queued in order.
+ */
+enum gui_event_type {
+    GUI_EVENT_NONE = 0,
+    /* Coalescing state */
+    GUI_EVENT_BATTERY,          /* value: percent */
+    GUI_EVENT_THERMAL,          /* value: degrees C */
+    GUI_EVENT_BRIGHTNESS,       /* value: 0..255 */
+    GUI_EVENT_NETWORK,          /* value: signal bars, -1 = offline */
+    GUI_EVENT_STATE_LAST = GUI_EVENT_NETWORK,
+    /* Queued */
+    GUI_EVENT_TOUCH,            /* point */
+    GUI_EVENT_GESTURE,          /* value: enum gesture_type (emit_gesture) */
+    GUI_EVENT_KEY,              /* pair: keycode, pressed */
+    GUI_EVENT_NOTIFY,           /* value: notification id */
+    GUI_EVENT_SETTING,          /* value: enum setting_key that changed */
+    GUI_EVENT_USER,             /* First free type for modules */
+    GUI_EVENT_MAX = 64,
+};
+
+struct gui_event {
+    int type;
+    uint32_t flags;
+    uint64_t time_ns;           /* Stamped at push, for latency */
+    union {
+        int32_t value;
+        struct { float x, y; } point;
+        struct { int32_t a, b; } pair;
+        uint64_t u64;
+    };
+};
+
+struct gui_event_stats {
+    uint64_t pushed;
+    uint64_t popped;
+    uint64_t coalesced;         /* State pushes that replaced an undelivered value */
+    uint64_t overflow;          /* Queued pushes dropped because the ring was full */
+    uint64_t latency_sum_ns;    /* Push -> pop */
+    uint64_t latency_max_ns;
+};
+
+#define GUI_EVENT_QUEUE_SIZE 1024   /* Power of two */
+
+/* Any thread. 0 on success, -1 when the queue is full (event dropped). */
+int gui_event_push(int type, int value);
+int gui_event_post(const struct gui_event *ev);
+
+/* Any thread. Pending state events come first, then queued ones in order. */
+int gui_event_pop(struct gui_event *out);
+int gui_event_pop_batch(struct gui_event *out, int max);
+
+void gui_event_get_stats(struct gui_event_stats *out);
+
+/* Types posted since the last call, as a bit per type (module scheduler) */
+uint64_t gui_event_take_fired(void);
+
+struct gui_event_bench_result {
+    uint64_t events;
+    double events_per_sec;
+    double avg_latency_us;
+    uint64_t overflow;
+};
+
+/* Producers post a touch/state mix; consumers batch-pop until all arrive */
+struct gui_event_bench_result gui_event_bench(int producers, int consumers, int events_per_producer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef GUI_MODULE_H
+#define GUI_MODULE_H
+
+#include "gui_event.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GUI_MAX_MODULES             32
+#define GUI_MODULE_DEFAULT_BUDGET   1000000ULL      /* ns per update */
+
+/*
+ * A module runs when its period elapses or an event it subscribes to was
+ * posted; with neither set it runs every frame. Nothing else is visited,
+ * so per-frame cost follows what is due, not what is registered.
+ */
+struct gui_module_desc {
+    const char *name;
+    void (*init)(void);
+    void (*update)(void);
+    uint64_t period_ns;         /* 0 = no periodic runs */
+    uint64_t events;            /* Bit (1 << type) per gui_event type that wakes it */
+    uint64_t budget_ns;         /* 0 = GUI_MODULE_DEFAULT_BUDGET */
+};
+
+struct gui_module_stats {
+    const char *name;
+    uint64_t runs;
+    uint64_t total_ns;
+    uint64_t max_ns;
+    uint64_t over_budget;       /* Runs that exceeded budget_ns */
+    uint64_t budget_ns;
+};
+
+struct gui_module {
+    struct gui_module_desc desc;
+    uint64_t next_due_ns;
+    struct gui_module_stats stats;
+};
+
+#define GUI_EVENT_BIT(type) (1ULL << (type))
+
+int gui_register_module(const char *name, void (*init)(void), void (*update)(void));
+int gui_register_module_ex(const struct gui_module_desc *desc);
+
+/* Overlays and telemetry monitors with their periods and event masks */
+int gui_register_builtin_modules(void);
+
+void gui_init_all(void);
+void gui_update_all(void);                  /* Runs what is due now */
+void gui_update_due(uint64_t now_ns);
+
+/* Called with the module's stats each time a run exceeds its budget */
+void gui_module_on_slow(void (*handler)(const struct gui_module_stats *st, uint64_t run_ns));
+
+int gui_module_count(void);
+int gui_module_get_stats(int index, struct gui_module_stats *out);
+/* Modules that went over budget, worst first; returns how many were written */
+int gui_module_report_slow(struct gui_module_stats *out, int max);
+
+/* Platform readings used by telemetry, popups and safety modules */
+int battery_percent(void);
+int thermal_celsius(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef GUI_OVERLAY_H
+#define GUI_OVERLAY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Updates sample what the overlay shows. The overlay layer is retained, so
+ * renders draw only text that changed, at a fixed width so the new text
+ * covers the old.
+ */
+void fps_overlay_update(void);
+void fps_overlay_render(void);
+void network_overlay_update(void);
+void network_overlay_render(void);
+void memory_overlay_render(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef GUI_SENSORS_H
+#define GUI_SENSORS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Same order as platform::mobile::SensorId */
+enum sensor_id {
+    SENSOR_BATTERY = 0,     /* percent */
+    SENSOR_CHARGER,         /* 0/1 */
+    SENSOR_THERMAL,         /* degrees C */
+    SENSOR_LIGHT,           /* lux */
+    SENSOR_COUNT
+};
+
+struct sensor_reading {
+    float value;
+    int64_t raw;
+    uint64_t time_ns;
+    uint32_t seq;           /* Bumps on each published change, 0 = no reading yet */
+};
+
+/* Starts the hub thread with the platform's sysfs/IIO nodes (idempotent) */
+int sensor_hub_start(void);
+void sensor_hub_stop(void);
+
+/* Latest published value; never blocks on file I/O. -1 before the first reading. */
+int sensor_read(int id, struct sensor_reading *out);
+
+/* Called on the hub thread after each published change (not the GUI thread) */
+int sensor_hub_watch(int id, void (*fn)(int id, float value));
+
+/* Telemetry: forward hub changes to GUI_EVENT_BATTERY / GUI_EVENT_THERMAL */
+void battery_monitor_init(void);
+void thermal_monitor_init(void);
+void battery_monitor_update(void);
+void thermal_monitor_update(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
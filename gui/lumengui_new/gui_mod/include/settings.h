@@ -0,0 +1,46 @@
+#ifndef GUI_SETTINGS_H
+#define GUI_SETTINGS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Same order as palisade::gui::settings::Setting */
+enum setting_key {
+    SETTING_ANIM_SPEED = 0,     /* float, 0.25..4 */
+    SETTING_LOW_POWER,          /* bool */
+    SETTING_UI_BRIGHTNESS,      /* float, 0.05..1 */
+    SETTING_COUNT
+};
+
+#define SETTING_BIT(key) (1ULL << (key))
+
+/* Maps the store and restores the last checkpoint (idempotent). NULL = default path. */
+int settings_open(const char *path);
+void settings_close(void);              /* Writes back; after the render thread stops */
+
+/* Lock-free single loads: cheap enough for every frame */
+float setting_get_f(int key);
+int setting_get_i(int key);
+
+/* Clamped to the key's range. 1 = changed, 0 = unchanged, -1 = bad key or not open. */
+int setting_set_f(int key, float value);
+int setting_set_i(int key, int value);
+
+/*
+ * fn runs on the writing thread right after the change is visible. Modules
+ * that want it on the GUI thread subscribe to GUI_EVENT_SETTING instead,
+ * which every change also posts (value: the key). Once settings_unwatch()
+ * returns, fn is not running and will not run again (a call from inside
+ * fn only waits for other threads).
+ */
+int settings_watch(uint64_t keys, void (*fn)(int key, void *user), void *user);
+void settings_unwatch(int id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,28 @@
+#include <overlay.h>
+
+static int frame_count = 0;
+static float elapsed = 0.0f;
+static int fps = 0;
+
+void fps_overlay_update(void) {
+    frame_count++;
+    elapsed += frame_delta();
+
+    if (elapsed >= 1.0f) {
+        fps = frame_count;
+        frame_count = 0;
+        elapsed = 0.0f;
+    }
+}
+
+/* Drawn only when the shown value changes (once a second at most) */
+static int shown_fps = -1;
+static char fps_buf[32];
+
+void fps_overlay_render(void) {
+    if (fps == shown_fps)
+        return;
+    shown_fps = fps;
+    snprintf(fps_buf, sizeof(fps_buf), "FPS: %3d", fps);
+    draw_text(fps_buf, 10, 10);
+}
@@ -0,0 +1,70 @@
+#include <overlay.h>
+#include <memory.h>
+#include <sys2Dengine.h>
+
+#define MEM_ROW_Y0      85  /* Below the network overlay line */
+#define MEM_ROW_H       14
+#define MEM_GROW_FRAMES 120
+
+/* Last peak seen per subsystem; a growing peak is flagged for a while */
+static unsigned long long seen_peak[SYS2D_MEM_NUM_TAGS];
+static int grow_frames[SYS2D_MEM_NUM_TAGS];
+
+/* Rows are formatted and drawn only when what they show changes */
+struct mem_row {
+    unsigned long long live_k, peak_k;
+    unsigned live_allocs;
+    int growing;
+    char text[64];
+};
+static struct mem_row rows[SYS2D_MEM_NUM_TAGS];
+static int shown_percent = -1;
+static char percent_buf[32];
+
+static void memory_overlay_render_subsystems(void) {
+    int y = MEM_ROW_Y0;
+
+    for (int t = 0; t < SYS2D_MEM_NUM_TAGS; t++) {
+        sys2d_mem_stats_t st;
+        if (sys2d_mem_query(t, &st) != 0)
+            continue;
+
+        if (st.peak_bytes > seen_peak[t]) {
+            if (seen_peak[t])
+                grow_frames[t] = MEM_GROW_FRAMES;
+            seen_peak[t] = st.peak_bytes;
+        } else if (grow_frames[t] > 0) {
+            grow_frames[t]--;
+        }
+
+        struct mem_row *r = &rows[t];
+        int growing = grow_frames[t] != 0;
+        if (!r->text[0] || r->live_k != st.live_bytes >> 10 || r->peak_k != st.peak_bytes >> 10 ||
+            r->live_allocs != st.live_allocs || r->growing != growing) {
+            r->live_k = st.live_bytes >> 10;
+            r->peak_k = st.peak_bytes >> 10;
+            r->live_allocs = st.live_allocs;
+            r->growing = growing;
+            snprintf(r->text, sizeof(r->text), "%c%-9s %6lluK pk %6lluK n%-6u",
+                     growing ? '+' : ' ', sys2d_mem_tag_name(t),
+                     r->live_k, r->peak_k, r->live_allocs);
+            draw_text(r->text, 10, y);
+        }
+        y += MEM_ROW_H;
+    }
+}
+
+void memory_overlay_render(void) {
+    unsigned long total, free;
+    page_stats(&total, &free);
+
+    int percent = (free * 100) / total;
+    if (percent != shown_percent) {
+        shown_percent = percent;
+        draw_bar(10, 30, 120, 8, percent);
+        snprintf(percent_buf, sizeof(percent_buf), "MEM %3d%%", percent);
+        draw_text(percent_buf, 10, 45);
+    }
+
+    memory_overlay_render_subsystems();
+}
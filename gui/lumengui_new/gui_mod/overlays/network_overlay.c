@@ -0,0 +1,23 @@
+#include <overlay.h>
+
+static unsigned long last_tx = 0;
+static unsigned long last_rx = 0;
+
+void network_overlay_update(void) {
+    last_tx = net_tx_bytes();
+    last_rx = net_rx_bytes();
+}
+
+/* Counters shown in KiB so the text changes far less often than the bytes */
+static unsigned long shown_tx = (unsigned long)-1;
+static unsigned long shown_rx = (unsigned long)-1;
+static char net_buf[64];
+
+void network_overlay_render(void) {
+    if ((last_tx >> 10) == shown_tx && (last_rx >> 10) == shown_rx)
+        return;
+    shown_tx = last_tx >> 10;
+    shown_rx = last_rx >> 10;
+    snprintf(net_buf, sizeof(net_buf), "TX:%8luK RX:%8luK", shown_tx, shown_rx);
+    draw_text(net_buf, 10, 65);
+}
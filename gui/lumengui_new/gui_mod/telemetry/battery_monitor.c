@@ -0,0 +1,29 @@
+#include <gui_module.h>
+#include <sensors.h>
+#include <math.h>
+#include <stdatomic.h>
+
+static _Atomic int last_level = 100;    /* Last value posted */
+
+/* Hub thread: the event bus is MPMC and coalesces, so post straight from here */
+static void battery_changed(int id, float value) {
+    (void)id;
+    int v = (int)lroundf(value);
+    atomic_store_explicit(&last_level, v, memory_order_relaxed);
+    gui_event_push(GUI_EVENT_BATTERY, v);
+}
+
+void battery_monitor_init(void) {
+    sensor_hub_watch(SENSOR_BATTERY, battery_changed);
+    sensor_hub_start();
+}
+
+/*
+ * Periodic fallback for a missed or absent hub notification: the snapshot
+ * read never blocks, and an unchanged value posts nothing.
+ */
+void battery_monitor_update(void) {
+    int v = battery_percent();
+    if (atomic_exchange_explicit(&last_level, v, memory_order_relaxed) != v)
+        gui_event_push(GUI_EVENT_BATTERY, v);
+}
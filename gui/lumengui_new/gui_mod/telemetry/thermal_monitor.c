@@ -0,0 +1,26 @@
+#include <gui_module.h>
+#include <sensors.h>
+#include <math.h>
+#include <stdatomic.h>
+
+static _Atomic int last_temp = 0;    /* Last value posted */
+
+/* Hub thread; the median filter and 0.5 C deadband already dropped jitter */
+static void thermal_changed(int id, float value) {
+    (void)id;
+    int v = (int)lroundf(value);
+    atomic_store_explicit(&last_temp, v, memory_order_relaxed);
+    gui_event_push(GUI_EVENT_THERMAL, v);
+}
+
+void thermal_monitor_init(void) {
+    sensor_hub_watch(SENSOR_THERMAL, thermal_changed);
+    sensor_hub_start();
+}
+
+/* Slow poll of the hub's cached reading, in case a change was not reported */
+void thermal_monitor_update(void) {
+    int v = thermal_celsius();
+    if (atomic_exchange_explicit(&last_temp, v, memory_order_relaxed) != v)
+        gui_event_push(GUI_EVENT_THERMAL, v);
+}
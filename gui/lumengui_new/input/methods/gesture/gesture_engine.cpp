@@ -0,0 +1,169 @@
+#include <gesture.h>
+#include <gui_event.h>
+#include <mutex>
+
+namespace palisade::gui::gesture {
+
+// Recognizers are state machines fed from the event stream. Per event each live
+// recognizer does O(1) work; the first one to recognize wins the sequence, the
+// rest are failed and the gesture is emitted exactly once. Timers (long press)
+// use deadlines, so nothing runs per frame unless a deadline is due.
+//
+// The touch driver feeds from the input thread and the frame loop ticks, so
+// both take the engine lock (uncontended but for the rare overlap).
+
+static std::mutex engineMutex;
+static gesture_recognizer* recognizers[GESTURE_MAX_RECOGNIZERS];
+static int recognizerCount = 0;
+
+static gesture_touches touches;
+static bool resolved = false;       // Winner emitted or every recognizer failed
+static uint64_t nextDeadline = 0;
+
+static void beginSequence(uint64_t timeNs) {
+    touches = gesture_touches{};
+    touches.start_ns = timeNs;
+    resolved = false;
+    for (int i = 0; i < recognizerCount; i++) {
+        gesture_recognizer* r = recognizers[i];
+        r->state = GESTURE_POSSIBLE;
+        r->deadline_ns = 0;
+        for (float& f : r->f) f = 0.0f;
+        if (r->reset) r->reset(r);
+    }
+}
+
+static void resolve(gesture_recognizer* winner) {
+    resolved = true;
+    for (int i = 0; i < recognizerCount; i++) {
+        recognizers[i]->deadline_ns = 0;
+        if (recognizers[i] != winner) recognizers[i]->state = GESTURE_FAILED;
+    }
+    if (winner) emit_gesture(winner->gesture);
+}
+
+// Settles the sequence once nobody is left, and caches the earliest armed timer
+static void refresh() {
+    nextDeadline = 0;
+    if (resolved) return;
+    bool live = false;
+    for (int i = 0; i < recognizerCount; i++) {
+        gesture_recognizer* r = recognizers[i];
+        if (r->state != GESTURE_POSSIBLE) continue;
+        live = true;
+        if (r->deadline_ns && (!nextDeadline || r->deadline_ns < nextDeadline)) {
+            nextDeadline = r->deadline_ns;
+        }
+    }
+    if (!live) resolve(nullptr);
+}
+
+static void trackTouch(const gesture_input& in) {
+    auto& pt = touches.pt[in.finger];
+    switch (in.type) {
+    case GESTURE_IN_DOWN:
+        if (!pt.down) {
+            touches.count++;
+            if (touches.count > touches.max_count) touches.max_count = touches.count;
+        }
+        pt.down = 1;
+        pt.x0 = pt.x = in.x;
+        pt.y0 = pt.y = in.y;
+        pt.t0 = in.time_ns;
+        break;
+    case GESTURE_IN_MOVE:
+        pt.x = in.x;
+        pt.y = in.y;
+        break;
+    case GESTURE_IN_UP:
+        if (pt.down) touches.count--;
+        pt.down = 0;
+        pt.x = in.x;
+        pt.y = in.y;
+        break;
+    }
+}
+
+}
+
+using namespace palisade::gui::gesture;
+
+// Winners go out on the GUI event bus, like any other input
+extern "C" void emit_gesture(int gesture) {
+    gui_event_push(GUI_EVENT_GESTURE, gesture);
+}
+
+extern "C" int gesture_engine_register(gesture_recognizer* r) {
+    std::lock_guard<std::mutex> lock(engineMutex);
+    if (recognizerCount >= GESTURE_MAX_RECOGNIZERS) return -1;
+    r->state = GESTURE_FAILED;  // Joins at the next sequence
+    recognizers[recognizerCount++] = r;
+    return 0;
+}
+
+extern "C" void gesture_engine_init(void) {
+    {
+        std::lock_guard<std::mutex> lock(engineMutex);
+        recognizerCount = 0;
+        resolved = true;
+        nextDeadline = 0;
+    }
+
+    // Registration order is arbitration priority for same-event ties
+    gesture_engine_register(&three_finger_recognizer);
+    gesture_engine_register(&pinch_recognizer);
+    gesture_engine_register(&edge_swipe_recognizer);
+    gesture_engine_register(&swipe_recognizer);
+    gesture_engine_register(&long_press_recognizer);
+    gesture_engine_register(&tap_recognizer);
+}
+
+extern "C" void gesture_engine_feed(const gesture_input* in) {
+    if (!in || in->finger < 0 || in->finger >= GESTURE_MAX_POINTS) return;
+    std::lock_guard<std::mutex> lock(engineMutex);
+
+    if (in->type == GESTURE_IN_CANCEL) {
+        resolve(nullptr);
+        touches = gesture_touches{};
+        nextDeadline = 0;
+        return;
+    }
+    if (in->type == GESTURE_IN_DOWN && touches.count == 0) beginSequence(in->time_ns);
+    if (in->type != GESTURE_IN_DOWN && !touches.pt[in->finger].down) return;  // Stray event
+
+    trackTouch(*in);
+    if (resolved) return;  // Sequence already decided: nothing to do until all fingers lift
+
+    for (int i = 0; i < recognizerCount; i++) {
+        gesture_recognizer* r = recognizers[i];
+        if (r->state != GESTURE_POSSIBLE) continue;
+        r->state = r->on_event(r, in, &touches);
+        if (r->state == GESTURE_RECOGNIZED) {
+            resolve(r);
+            break;
+        }
+    }
+    refresh();
+}
+
+extern "C" uint64_t gesture_engine_next_deadline(void) {
+    std::lock_guard<std::mutex> lock(engineMutex);
+    return nextDeadline;
+}
+
+extern "C" void gesture_engine_tick(uint64_t nowNs) {
+    std::lock_guard<std::mutex> lock(engineMutex);
+    if (!nextDeadline || nowNs < nextDeadline) return;  // The common per-frame case
+
+    for (int i = 0; i < recognizerCount; i++) {
+        gesture_recognizer* r = recognizers[i];
+        if (r->state != GESTURE_POSSIBLE || !r->deadline_ns || nowNs < r->deadline_ns) continue;
+        r->deadline_ns = 0;
+        r->state = r->on_deadline ? r->on_deadline(r, nowNs, &touches) : GESTURE_FAILED;
+        if (r->state == GESTURE_RECOGNIZED) {
+            resolve(r);
+            break;
+        }
+    }
+    refresh();
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+
+namespace palisade::gui::touch {
+
+constexpr int kMaxFingers = 10;
+constexpr int kHistorySize = 16;  // Per finger, ~60 ms at a 240 Hz panel
+
+// Raw sample as reported by the panel (timestamp in ns, monotonic)
+struct TouchSample {
+    float x;
+    float y;
+    int pressure;
+    uint64_t timeNs;
+};
+
+// Position handed to the frame: resampled to the frame time, optionally predicted
+struct TouchPoint {
+    float x;
+    float y;
+    float vx;  // px/s
+    float vy;
+    bool predicted;
+};
+
+// Noise filter (1-euro: low cutoff while still, opens up with speed) + prediction
+struct FilterParams {
+    int pressureThreshold = 2;
+    float minCutoffHz = 1.5f;     // Lower = smoother when the finger rests
+    float beta = 0.02f;           // Higher = less lag on fast drags
+    float dCutoffHz = 1.0f;       // Cutoff for the speed estimate itself
+    bool predict = true;
+    float maxPredictMs = 20.0f;   // Never extrapolate further than this
+    float maxPredictPx = 48.0f;
+    float minPredictSpeed = 60.0f; // px/s; below this the finger counts as resting
+};
+
+// touch_driver.cpp
+void onTouch(int x, int y);
+void onTouch(int finger, int x, int y, int pressure, uint64_t timeNs);
+void onRelease(int finger);
+void setTimeSource(uint64_t (*nowNs)());
+
+// touch_state.cpp
+void setFingers(int c);
+int activeFingers();
+void pushSample(int finger, const TouchSample& s);
+void clearFinger(int finger);
+int historyCount(int finger);
+const TouchSample* historyAt(int finger, int age);  // age 0 = newest
+
+// touch_filter.cpp
+bool filterNoise(int pressure);
+void setFilterParams(const FilterParams& p);
+const FilterParams& filterParams();
+void resetFilter(int finger);
+void reportPresent(uint64_t frameTimeNs, uint64_t presentNs);
+uint64_t displayLatencyNs();
+bool sampleForFrame(int finger, uint64_t frameTimeNs, TouchPoint& out);
+
+}
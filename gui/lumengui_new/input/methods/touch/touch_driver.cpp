@@ -0,0 +1,46 @@
+#include "touch.hpp"
+#include "../../../core/timing/frame_pacer.hpp"
+#include <gesture.h>
+
+namespace palisade::gui::touch {
+
+constexpr uint64_t kDefaultScanNs = 8333333;  // 120 Hz panel when no clock is bound
+
+static uint64_t (*clockNs)() = nullptr;
+static uint64_t lastLegacyNs = 0;
+
+void setTimeSource(uint64_t (*nowNs)()) {
+    clockNs = nowNs;
+}
+
+// Legacy entry point: finger 0, stamped from the bound clock
+void onTouch(int x, int y) {
+    uint64_t t = clockNs ? clockNs() : lastLegacyNs + kDefaultScanNs;
+    lastLegacyNs = t;
+    onTouch(0, x, y, filterParams().pressureThreshold + 1, t);
+}
+
+// Raw samples also drive the gesture recognizers, as events rather than per frame
+void onTouch(int finger, int x, int y, int pressure, uint64_t timeNs) {
+    if (!filterNoise(pressure)) return;
+    bool down = historyCount(finger) == 0;
+    if (down) resetFilter(finger);  // New contact
+    pushSample(finger, {static_cast<float>(x), static_cast<float>(y), pressure, timeNs});
+
+    gesture_input in{down ? GESTURE_IN_DOWN : GESTURE_IN_MOVE, finger,
+                     static_cast<float>(x), static_cast<float>(y), timeNs};
+    gesture_engine_feed(&in);
+    time::framePacer().invalidate(time::FrameInput);
+}
+
+void onRelease(int finger) {
+    if (const TouchSample* last = historyAt(finger, 0)) {
+        gesture_input in{GESTURE_IN_UP, finger, last->x, last->y, clockNs ? clockNs() : last->timeNs};
+        gesture_engine_feed(&in);
+        time::framePacer().invalidate(time::FrameInput);
+    }
+    clearFinger(finger);
+    resetFilter(finger);
+}
+
+}
@@ -0,0 +1,160 @@
+#include "touch.hpp"
+#include <cmath>
+
+namespace palisade::gui::touch {
+
+constexpr uint64_t kVelocityWindowNs = 40000000;  // Fit velocity over the last 40 ms
+constexpr float kPi = 3.14159265f;
+
+static FilterParams params;
+static uint64_t latencyNs = 0;  // EWMA of frame time -> photons, 0 until measured
+
+// 1-euro filter state per finger (runs on the resampled, per-frame positions)
+struct FilterState {
+    bool init = false;
+    float x = 0, y = 0;
+    float dx = 0, dy = 0;
+    uint64_t lastNs = 0;
+    TouchPoint last{};      // Result for lastNs: repeat calls for one frame get the same point
+};
+
+static FilterState state[kMaxFingers];
+
+bool filterNoise(int pressure) {
+    return pressure > params.pressureThreshold;
+}
+
+void setFilterParams(const FilterParams& p) {
+    params = p;
+}
+
+const FilterParams& filterParams() {
+    return params;
+}
+
+void resetFilter(int finger) {
+    if (finger >= 0 && finger < kMaxFingers) state[finger] = FilterState{};
+}
+
+void reportPresent(uint64_t frameTimeNs, uint64_t presentNs) {
+    if (presentNs <= frameTimeNs) return;
+    uint64_t sample = presentNs - frameTimeNs;
+    latencyNs = latencyNs ? (latencyNs * 7 + sample) / 8 : sample;
+}
+
+uint64_t displayLatencyNs() {
+    return latencyNs;
+}
+
+static float smoothing(float cutoffHz, float dtSec) {
+    float tau = 1.0f / (2.0f * kPi * cutoffHz);
+    return 1.0f / (1.0f + tau / dtSec);
+}
+
+// Least-squares slope over the recent window: far less noisy than a two-point difference
+static void fitVelocity(int finger, float& vx, float& vy) {
+    const TouchSample* newest = historyAt(finger, 0);
+    float st = 0, sx = 0, sy = 0, stt = 0, stx = 0, sty = 0;
+    int n = 0;
+    for (int age = 0; age < historyCount(finger); age++) {
+        const TouchSample* s = historyAt(finger, age);
+        if (newest->timeNs - s->timeNs > kVelocityWindowNs) break;
+        float t = -static_cast<float>(newest->timeNs - s->timeNs) * 1e-9f;
+        st += t; sx += s->x; sy += s->y;
+        stt += t * t; stx += t * s->x; sty += t * s->y;
+        n++;
+    }
+    float denom = n * stt - st * st;
+    if (n < 2 || denom <= 0.0f) {
+        vx = vy = 0.0f;
+        return;
+    }
+    vx = (n * stx - st * sx) / denom;
+    vy = (n * sty - st * sy) / denom;
+}
+
+bool sampleForFrame(int finger, uint64_t frameTimeNs, TouchPoint& out) {
+    int n = historyCount(finger);
+    if (n == 0) return false;
+    const TouchSample* newest = historyAt(finger, 0);
+
+    // A finger may be sampled more than once for one frame; stepping the filter
+    // twice at dt = 0 would jump, so repeat calls get the first result
+    FilterState& f = state[finger];
+    if (f.init && frameTimeNs == f.lastNs) {
+        out = f.last;
+        return true;
+    }
+
+    float vx, vy;
+    fitVelocity(finger, vx, vy);
+
+    float x, y;
+    bool predicted = false;
+    if (frameTimeNs <= newest->timeNs) {
+        // Frame time falls inside the history: interpolate between the bracketing samples
+        const TouchSample* a = historyAt(finger, n - 1);
+        const TouchSample* b = newest;
+        for (int age = 1; age < n; age++) {
+            const TouchSample* s = historyAt(finger, age);
+            if (s->timeNs <= frameTimeNs) {
+                a = s;
+                b = historyAt(finger, age - 1);
+                break;
+            }
+        }
+        if (frameTimeNs <= a->timeNs || a == b) {
+            x = a->x;
+            y = a->y;
+        } else {
+            float f = static_cast<float>(frameTimeNs - a->timeNs) / static_cast<float>(b->timeNs - a->timeNs);
+            x = a->x + (b->x - a->x) * f;
+            y = a->y + (b->y - a->y) * f;
+        }
+    } else {
+        x = newest->x;
+        y = newest->y;
+    }
+
+    // Extrapolate to the frame time and, if enabled, further by the display latency
+    float speed = std::sqrt(vx * vx + vy * vy);
+    uint64_t horizonNs = frameTimeNs > newest->timeNs ? frameTimeNs - newest->timeNs : 0;
+    if (params.predict) horizonNs += latencyNs;
+    if (horizonNs && speed >= params.minPredictSpeed) {
+        float h = std::fmin(horizonNs * 1e-9f, params.maxPredictMs * 1e-3f);
+        float px = vx * h, py = vy * h;
+        float len = std::sqrt(px * px + py * py);
+        if (len > params.maxPredictPx) {
+            px *= params.maxPredictPx / len;
+            py *= params.maxPredictPx / len;
+        }
+        x += px;
+        y += py;
+        predicted = true;
+    }
+
+    // 1-euro filter: cutoff rises with speed, so drags stay tight and rests stay still.
+    // Time going backwards (clock reset, replay) restarts it.
+    if (!f.init || frameTimeNs < f.lastNs) {
+        f.init = true;
+        f.x = x;
+        f.y = y;
+        f.dx = f.dy = 0.0f;
+    } else {
+        float dt = (frameTimeNs - f.lastNs) * 1e-9f;
+        float ad = smoothing(params.dCutoffHz, dt);
+        f.dx += ad * ((x - f.x) / dt - f.dx);
+        f.dy += ad * ((y - f.y) / dt - f.dy);
+        float cutoff = params.minCutoffHz + params.beta * std::sqrt(f.dx * f.dx + f.dy * f.dy);
+        float a = smoothing(cutoff, dt);
+        f.x += a * (x - f.x);
+        f.y += a * (y - f.y);
+    }
+    f.lastNs = frameTimeNs;
+
+    out = {f.x, f.y, vx, vy, predicted};
+    f.last = out;
+    return true;
+}
+
+}
@@ -0,0 +1,56 @@
+#include "touch.hpp"
+
+namespace palisade::gui::touch {
+
+static int fingers = 0;
+
+// Timestamped ring per finger; samples arrive at the panel scan rate
+struct FingerHistory {
+    TouchSample samples[kHistorySize];
+    int head = 0;   // Next write slot
+    int count = 0;
+};
+
+static FingerHistory history[kMaxFingers];
+
+void setFingers(int c) {
+    fingers = c;
+}
+
+int activeFingers() {
+    return fingers;
+}
+
+void pushSample(int finger, const TouchSample& s) {
+    if (finger < 0 || finger >= kMaxFingers) return;
+    FingerHistory& h = history[finger];
+
+    // Out-of-order or duplicate timestamps would break interpolation
+    if (h.count && s.timeNs <= historyAt(finger, 0)->timeNs) return;
+
+    if (h.count == 0) fingers++;
+    h.samples[h.head] = s;
+    h.head = (h.head + 1) % kHistorySize;
+    if (h.count < kHistorySize) h.count++;
+}
+
+void clearFinger(int finger) {
+    if (finger < 0 || finger >= kMaxFingers) return;
+    if (history[finger].count && fingers > 0) fingers--;
+    history[finger].head = 0;
+    history[finger].count = 0;
+}
+
+int historyCount(int finger) {
+    if (finger < 0 || finger >= kMaxFingers) return 0;
+    return history[finger].count;
+}
+
+const TouchSample* historyAt(int finger, int age) {
+    if (finger < 0 || finger >= kMaxFingers) return nullptr;
+    const FingerHistory& h = history[finger];
+    if (age < 0 || age >= h.count) return nullptr;
+    return &h.samples[(h.head - 1 - age + kHistorySize) % kHistorySize];
+}
+
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include "string_table.hpp"
+
+namespace palisade::gui::locale {
+
+void setTableDirectory(const char* dir);   // Where <code>.lstb files live
+bool setLanguage(const char* code);        // Maps the table on first use; false keeps the current one
+void setLanguage(int id);
+int current();
+const char* currentCode();
+const char* languageCode(int id);   // nullptr for unknown ids
+const StringTable* activeTable();
+
+// Never allocates; the pointer stays valid for the life of the process
+const char* lookup(StringKey id);
+const char* fallbackLookup(StringKey id);
+
+bool isRTL(int lang);
+
+}
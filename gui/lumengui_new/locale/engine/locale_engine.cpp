@@ -0,0 +1,82 @@
+#include "locale.hpp"
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace palisade::gui::locale {
+
+struct Language {
+    const char* code;
+    bool rtl;           // Written right to left; the UI mirrors
+};
+
+// Index = language id; matches the directories under locale/languages. None
+// of the shipped catalogs is RTL yet; one that is sets rtl here.
+static const Language kLanguages[] = {
+    {"en_us", false}, {"ro", false}, {"sv", false}, {"es", false},
+    {"pt", false},    {"it", false}, {"fr", false}, {"no", false},
+    {"tr", false},    {"nl", false}, {"sw", false}, {"af", false},
+    {"eo", false},    {"id", false}, {"de", false}, {"tl", false},
+};
+constexpr int kLanguageCount = sizeof(kLanguages) / sizeof(kLanguages[0]);
+
+static std::mutex loadMutex;
+static char tableDir[256] = "locale";
+static std::unique_ptr<StringTable> tables[kLanguageCount];   // Stay mapped once loaded
+static std::atomic<const StringTable*> active{nullptr};
+static std::atomic<int> lang{0};
+
+void setTableDirectory(const char* dir) {
+    std::lock_guard<std::mutex> lock(loadMutex);
+    snprintf(tableDir, sizeof(tableDir), "%s", dir);
+}
+
+// Tables are never unmapped, so strings handed out before a switch stay
+// valid; switching back to a loaded language is a pointer store
+bool setLanguage(const char* code) {
+    int id = -1;
+    for (int i = 0; i < kLanguageCount; i++) {
+        if (strcmp(kLanguages[i].code, code) == 0) id = i;
+    }
+    if (id < 0) return false;
+
+    std::lock_guard<std::mutex> lock(loadMutex);
+    if (!tables[id]) {
+        char path[320];
+        snprintf(path, sizeof(path), "%s/%s.lstb", tableDir, code);
+        auto t = std::make_unique<StringTable>();
+        if (!t->open(path)) return false;
+        tables[id] = std::move(t);
+    }
+    active.store(tables[id].get(), std::memory_order_release);
+    lang.store(id, std::memory_order_relaxed);
+    return true;
+}
+
+void setLanguage(int id) {
+    if (id >= 0 && id < kLanguageCount) setLanguage(kLanguages[id].code);
+}
+
+int current() {
+    return lang.load(std::memory_order_relaxed);
+}
+
+const char* currentCode() {
+    return kLanguages[current()].code;
+}
+
+const char* languageCode(int id) {
+    return id >= 0 && id < kLanguageCount ? kLanguages[id].code : nullptr;
+}
+
+bool isRTL(int lang) {
+    return lang >= 0 && lang < kLanguageCount && kLanguages[lang].rtl;
+}
+
+const StringTable* activeTable() {
+    return active.load(std::memory_order_acquire);
+}
+
+}
@@ -0,0 +1,381 @@
+#include "text_layout.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace palisade::gui::locale {
+
+struct BidiRange {
+    uint32_t first, last;
+    BidiClass cls;
+};
+
+// Sorted and disjoint; codepoints outside every range are L. Covers ASCII,
+// Latin-1, Hebrew, Arabic, Syriac, Thaana, NKo, the punctuation, symbol and
+// presentation-form blocks, and the explicit formatting characters.
+static const BidiRange kRanges[] = {
+    {0x0000, 0x0008, BidiBN}, {0x0009, 0x0009, BidiS}, {0x000A, 0x000A, BidiB}, {0x000B, 0x000B, BidiS},
+    {0x000C, 0x000C, BidiWS}, {0x000D, 0x000D, BidiB}, {0x000E, 0x001B, BidiBN}, {0x001C, 0x001E, BidiB},
+    {0x001F, 0x001F, BidiS}, {0x0020, 0x0020, BidiWS}, {0x0021, 0x0022, BidiON}, {0x0023, 0x0025, BidiET},
+    {0x0026, 0x002A, BidiON}, {0x002B, 0x002B, BidiES}, {0x002C, 0x002C, BidiCS}, {0x002D, 0x002D, BidiES},
+    {0x002E, 0x002F, BidiCS}, {0x0030, 0x0039, BidiEN}, {0x003A, 0x003A, BidiCS}, {0x003B, 0x0040, BidiON},
+    {0x005B, 0x0060, BidiON}, {0x007B, 0x007E, BidiON}, {0x007F, 0x0084, BidiBN}, {0x0085, 0x0085, BidiB},
+    {0x0086, 0x009F, BidiBN}, {0x00A0, 0x00A0, BidiCS}, {0x00A1, 0x00A1, BidiON}, {0x00A2, 0x00A5, BidiET},
+    {0x00A6, 0x00A9, BidiON}, {0x00AB, 0x00AC, BidiON}, {0x00AD, 0x00AD, BidiBN}, {0x00AE, 0x00AF, BidiON},
+    {0x00B0, 0x00B1, BidiET}, {0x00B2, 0x00B3, BidiEN}, {0x00B4, 0x00B4, BidiON}, {0x00B6, 0x00B8, BidiON},
+    {0x00B9, 0x00B9, BidiEN}, {0x00BB, 0x00BF, BidiON}, {0x00D7, 0x00D7, BidiON}, {0x00F7, 0x00F7, BidiON},
+    {0x0300, 0x036F, BidiNSM}, {0x0483, 0x0489, BidiNSM},
+    {0x0590, 0x0590, BidiR}, {0x0591, 0x05BD, BidiNSM}, {0x05BE, 0x05BE, BidiR}, {0x05BF, 0x05BF, BidiNSM},
+    {0x05C0, 0x05C0, BidiR}, {0x05C1, 0x05C2, BidiNSM}, {0x05C3, 0x05C3, BidiR}, {0x05C4, 0x05C5, BidiNSM},
+    {0x05C6, 0x05C6, BidiR}, {0x05C7, 0x05C7, BidiNSM}, {0x05C8, 0x05FF, BidiR},
+    {0x0600, 0x0605, BidiAN}, {0x0606, 0x0607, BidiON}, {0x0608, 0x0608, BidiAL}, {0x0609, 0x060A, BidiET},
+    {0x060B, 0x060B, BidiAL}, {0x060C, 0x060C, BidiCS}, {0x060D, 0x060D, BidiAL}, {0x060E, 0x060F, BidiON},
+    {0x0610, 0x061A, BidiNSM}, {0x061B, 0x064A, BidiAL}, {0x064B, 0x065F, BidiNSM}, {0x0660, 0x0669, BidiAN},
+    {0x066A, 0x066A, BidiET}, {0x066B, 0x066C, BidiAN}, {0x066D, 0x066F, BidiAL}, {0x0670, 0x0670, BidiNSM},
+    {0x0671, 0x06D5, BidiAL}, {0x06D6, 0x06DC, BidiNSM}, {0x06DD, 0x06DD, BidiAN}, {0x06DE, 0x06DE, BidiON},
+    {0x06DF, 0x06E4, BidiNSM}, {0x06E5, 0x06E6, BidiAL}, {0x06E7, 0x06E8, BidiNSM}, {0x06E9, 0x06E9, BidiON},
+    {0x06EA, 0x06ED, BidiNSM}, {0x06EE, 0x06EF, BidiAL}, {0x06F0, 0x06F9, BidiEN}, {0x06FA, 0x0710, BidiAL},
+    {0x0711, 0x0711, BidiNSM}, {0x0712, 0x072F, BidiAL}, {0x0730, 0x074A, BidiNSM}, {0x074B, 0x07A5, BidiAL},
+    {0x07A6, 0x07B0, BidiNSM}, {0x07B1, 0x07BF, BidiAL}, {0x07C0, 0x07EA, BidiR}, {0x07EB, 0x07F3, BidiNSM},
+    {0x07F4, 0x07FF, BidiR}, {0x0800, 0x085F, BidiR}, {0x0860, 0x08D2, BidiAL}, {0x08D3, 0x08FF, BidiNSM},
+    {0x2000, 0x200A, BidiWS}, {0x200B, 0x200D, BidiBN}, {0x200F, 0x200F, BidiR}, {0x2010, 0x2027, BidiON},
+    {0x2028, 0x2028, BidiWS}, {0x2029, 0x2029, BidiB}, {0x202A, 0x202A, BidiLRE}, {0x202B, 0x202B, BidiRLE},
+    {0x202C, 0x202C, BidiPDF}, {0x202D, 0x202D, BidiLRO}, {0x202E, 0x202E, BidiRLO}, {0x202F, 0x202F, BidiCS},
+    {0x2030, 0x2034, BidiET}, {0x2035, 0x2043, BidiON}, {0x2044, 0x2044, BidiCS}, {0x2045, 0x205E, BidiON},
+    {0x205F, 0x205F, BidiWS}, {0x2060, 0x2064, BidiBN}, {0x2066, 0x2066, BidiLRI}, {0x2067, 0x2067, BidiRLI},
+    {0x2068, 0x2068, BidiFSI}, {0x2069, 0x2069, BidiPDI}, {0x206A, 0x206F, BidiBN}, {0x2070, 0x2070, BidiEN},
+    {0x2074, 0x2079, BidiEN}, {0x207A, 0x207B, BidiES}, {0x207C, 0x207E, BidiON}, {0x2080, 0x2089, BidiEN},
+    {0x208A, 0x208B, BidiES}, {0x208C, 0x208E, BidiON}, {0x20A0, 0x20CF, BidiET}, {0x20D0, 0x20F0, BidiNSM},
+    {0x2190, 0x2211, BidiON}, {0x2212, 0x2212, BidiES}, {0x2213, 0x2213, BidiET}, {0x2214, 0x2487, BidiON},
+    {0x2488, 0x249B, BidiEN}, {0x24EA, 0x2BFF, BidiON}, {0x2E00, 0x2E7F, BidiON}, {0x3000, 0x3000, BidiWS},
+    {0x3001, 0x3004, BidiON}, {0x3008, 0x3020, BidiON}, {0x302A, 0x302D, BidiNSM}, {0x3030, 0x3030, BidiON},
+    {0x303D, 0x303F, BidiON}, {0x3099, 0x309A, BidiNSM}, {0x309B, 0x309C, BidiON}, {0x30A0, 0x30A0, BidiON},
+    {0x30FB, 0x30FB, BidiON},
+    {0xFB1D, 0xFB1D, BidiR}, {0xFB1E, 0xFB1E, BidiNSM}, {0xFB1F, 0xFB28, BidiR}, {0xFB29, 0xFB29, BidiES},
+    {0xFB2A, 0xFB4F, BidiR}, {0xFB50, 0xFD3D, BidiAL}, {0xFD3E, 0xFD3F, BidiON}, {0xFD40, 0xFDFF, BidiAL},
+    {0xFE00, 0xFE0F, BidiNSM}, {0xFE10, 0xFE19, BidiON}, {0xFE20, 0xFE2F, BidiNSM}, {0xFE30, 0xFE4F, BidiON},
+    {0xFE50, 0xFE50, BidiCS}, {0xFE51, 0xFE51, BidiON}, {0xFE52, 0xFE52, BidiCS}, {0xFE54, 0xFE54, BidiON},
+    {0xFE55, 0xFE55, BidiCS}, {0xFE56, 0xFE5E, BidiON}, {0xFE5F, 0xFE5F, BidiET}, {0xFE60, 0xFE61, BidiON},
+    {0xFE62, 0xFE63, BidiES}, {0xFE64, 0xFE66, BidiON}, {0xFE68, 0xFE68, BidiON}, {0xFE69, 0xFE6A, BidiET},
+    {0xFE6B, 0xFE6B, BidiON}, {0xFE70, 0xFEFE, BidiAL}, {0xFEFF, 0xFEFF, BidiBN}, {0xFF01, 0xFF02, BidiON},
+    {0xFF03, 0xFF05, BidiET}, {0xFF06, 0xFF0A, BidiON}, {0xFF0B, 0xFF0B, BidiES}, {0xFF0C, 0xFF0C, BidiCS},
+    {0xFF0D, 0xFF0D, BidiES}, {0xFF0E, 0xFF0F, BidiCS}, {0xFF10, 0xFF19, BidiEN}, {0xFF1A, 0xFF1A, BidiCS},
+    {0xFF1B, 0xFF20, BidiON}, {0xFF3B, 0xFF40, BidiON}, {0xFF5B, 0xFF65, BidiON}, {0xFFE0, 0xFFE1, BidiET},
+    {0xFFE2, 0xFFE4, BidiON}, {0xFFE5, 0xFFE6, BidiET}, {0xFFE8, 0xFFEE, BidiON}, {0xFFF9, 0xFFFD, BidiON},
+    {0x10800, 0x10FFF, BidiR}, {0x1E800, 0x1EDFF, BidiR}, {0x1EE00, 0x1EEFF, BidiAL}, {0x1F000, 0x1FAFF, BidiON},
+    {0xE0001, 0xE007F, BidiBN},
+};
+
+BidiClass bidiClass(uint32_t cp) {
+    if (cp >= 'A' && cp <= 'z' && (cp <= 'Z' || cp >= 'a')) return BidiL;
+    const BidiRange* end = kRanges + sizeof(kRanges) / sizeof(kRanges[0]);
+    const BidiRange* r = std::upper_bound(kRanges, end, cp, [](uint32_t c, const BidiRange& b) { return c < b.first; });
+    if (r == kRanges || cp > (r - 1)->last) return BidiL;
+    return (r - 1)->cls;
+}
+
+uint32_t bidiMirror(uint32_t cp) {
+    static const uint32_t pairs[][2] = {
+        {0x0028, 0x0029}, {0x003C, 0x003E}, {0x005B, 0x005D}, {0x007B, 0x007D}, {0x00AB, 0x00BB},
+        {0x2039, 0x203A}, {0x2045, 0x2046}, {0x207D, 0x207E}, {0x208D, 0x208E}, {0x2264, 0x2265},
+        {0x3008, 0x3009}, {0x300A, 0x300B}, {0x300C, 0x300D}, {0x300E, 0x300F}, {0x3010, 0x3011},
+        {0x3014, 0x3015}, {0xFF08, 0xFF09}, {0xFF1C, 0xFF1E}, {0xFF3B, 0xFF3D}, {0xFF5B, 0xFF5D},
+    };
+    for (const auto& p : pairs) {
+        if (cp == p[0]) return p[1];
+        if (cp == p[1]) return p[0];
+    }
+    return cp;
+}
+
+static bool isIsolateInitiator(BidiClass c) {
+    return c == BidiLRI || c == BidiRLI || c == BidiFSI;
+}
+
+static bool isNeutral(BidiClass c) {
+    return c == BidiB || c == BidiS || c == BidiWS || c == BidiON || isIsolateInitiator(c) || c == BidiPDI;
+}
+
+// N1: numbers count as R
+static BidiClass strongDirection(BidiClass c) {
+    return c == BidiL ? BidiL : BidiR;
+}
+
+// P2/P3 over [from, to), skipping isolates: 0 = L, 1 = R, -1 = none
+static int firstStrong(const BidiClass* c, const std::vector<int32_t>& matchingPdi, size_t from, size_t to) {
+    for (size_t i = from; i < to; i++) {
+        if (c[i] == BidiL) return 0;
+        if (c[i] == BidiR || c[i] == BidiAL) return 1;
+        if (c[i] == BidiB) break;
+        if (isIsolateInitiator(c[i])) {
+            if (matchingPdi[i] < 0) break;
+            i = static_cast<size_t>(matchingPdi[i]);
+        }
+    }
+    return -1;
+}
+
+// W1-W7, N1-N2 and I1-I2 over one isolating run sequence
+static void resolveSequence(const std::vector<uint32_t>& seq, BidiClass* t, uint8_t* levels, BidiClass sos, BidiClass eos) {
+    size_t n = seq.size();
+    uint8_t level = levels[seq[0]];
+
+    BidiClass prev = sos;
+    for (size_t k = 0; k < n; k++) {
+        BidiClass& c = t[seq[k]];
+        if (c == BidiNSM) c = (isIsolateInitiator(prev) || prev == BidiPDI) ? BidiON : prev;
+        prev = c;
+    }
+
+    BidiClass strong = sos;
+    for (size_t k = 0; k < n; k++) {
+        BidiClass& c = t[seq[k]];
+        if (c == BidiL || c == BidiR || c == BidiAL) strong = c;
+        else if (c == BidiEN && strong == BidiAL) c = BidiAN;
+    }
+    for (size_t k = 0; k < n; k++) {
+        if (t[seq[k]] == BidiAL) t[seq[k]] = BidiR;
+    }
+
+    for (size_t k = 1; k + 1 < n; k++) {
+        BidiClass& c = t[seq[k]];
+        BidiClass a = t[seq[k - 1]], b = t[seq[k + 1]];
+        if (c == BidiES && a == BidiEN && b == BidiEN) c = BidiEN;
+        else if (c == BidiCS && a == b && (a == BidiEN || a == BidiAN)) c = a;
+    }
+
+    for (size_t k = 0; k < n;) {
+        if (t[seq[k]] != BidiET) {
+            k++;
+            continue;
+        }
+        size_t j = k;
+        while (j < n && t[seq[j]] == BidiET) j++;
+        bool touchesEN = (k > 0 && t[seq[k - 1]] == BidiEN) || (j < n && t[seq[j]] == BidiEN);
+        for (size_t m = k; m < j && touchesEN; m++) t[seq[m]] = BidiEN;
+        k = j;
+    }
+
+    for (size_t k = 0; k < n; k++) {
+        BidiClass& c = t[seq[k]];
+        if (c == BidiES || c == BidiET || c == BidiCS) c = BidiON;
+    }
+
+    strong = sos;
+    for (size_t k = 0; k < n; k++) {
+        BidiClass& c = t[seq[k]];
+        if (c == BidiL || c == BidiR) strong = c;
+        else if (c == BidiEN && strong == BidiL) c = BidiL;
+    }
+
+    BidiClass embedding = (level & 1) ? BidiR : BidiL;
+    for (size_t k = 0; k < n;) {
+        if (!isNeutral(t[seq[k]])) {
+            k++;
+            continue;
+        }
+        size_t j = k;
+        while (j < n && isNeutral(t[seq[j]])) j++;
+        BidiClass before = k == 0 ? sos : strongDirection(t[seq[k - 1]]);
+        BidiClass after = j == n ? eos : strongDirection(t[seq[j]]);
+        BidiClass resolved = before == after ? before : embedding;
+        for (size_t m = k; m < j; m++) t[seq[m]] = resolved;
+        k = j;
+    }
+
+    for (size_t k = 0; k < n; k++) {
+        uint8_t& l = levels[seq[k]];
+        BidiClass c = t[seq[k]];
+        if (!(l & 1)) {
+            if (c == BidiR) l += 1;
+            else if (c == BidiAN || c == BidiEN) l += 2;
+        } else if (c == BidiL || c == BidiEN || c == BidiAN) {
+            l += 1;
+        }
+    }
+}
+
+int bidiResolve(const BidiClass* in, size_t n, int baseLevel, uint8_t* levels) {
+    // BD9: matching PDI of each isolate initiator
+    std::vector<int32_t> matchingPdi(n, -1);
+    std::vector<bool> matchedPdi(n, false);
+    std::vector<uint32_t> open;
+    for (size_t i = 0; i < n; i++) {
+        if (isIsolateInitiator(in[i])) {
+            open.push_back(static_cast<uint32_t>(i));
+        } else if (in[i] == BidiPDI && !open.empty()) {
+            matchingPdi[open.back()] = static_cast<int32_t>(i);
+            matchedPdi[i] = true;
+            open.pop_back();
+        }
+    }
+
+    int para = baseLevel >= 0 ? baseLevel : (firstStrong(in, matchingPdi, 0, n) == 1 ? 1 : 0);
+
+    // X1-X8: explicit embeddings, overrides and isolates
+    constexpr int kMaxDepth = 125;
+    struct Status {
+        uint8_t level;
+        BidiClass override;     // ON = none
+        bool isolate;
+    };
+    Status stack[kMaxDepth + 2];
+    int sp = 0;
+    stack[0] = {static_cast<uint8_t>(para), BidiON, false};
+    int overflowIsolate = 0, overflowEmbedding = 0, validIsolate = 0;
+    std::vector<BidiClass> t(in, in + n);
+
+    auto nextLevel = [](uint8_t cur, bool rtl) { return rtl ? ((cur + 1) | 1) : ((cur + 2) & ~1); };
+    for (size_t i = 0; i < n; i++) {
+        BidiClass c = in[i];
+        Status& top = stack[sp];
+        switch (c) {
+        case BidiRLE: case BidiLRE: case BidiRLO: case BidiLRO: {
+            int nl = nextLevel(top.level, c == BidiRLE || c == BidiRLO);
+            levels[i] = top.level;
+            if (nl <= kMaxDepth && !overflowIsolate && !overflowEmbedding) {
+                stack[++sp] = {static_cast<uint8_t>(nl), c == BidiRLO ? BidiR : c == BidiLRO ? BidiL : BidiON, false};
+            } else if (!overflowIsolate) {
+                overflowEmbedding++;
+            }
+            t[i] = BidiBN;  // X9
+            break;
+        }
+        case BidiRLI: case BidiLRI: case BidiFSI: {
+            levels[i] = top.level;
+            if (top.override != BidiON) t[i] = top.override;
+            size_t end = matchingPdi[i] < 0 ? n : static_cast<size_t>(matchingPdi[i]);
+            bool rtl = c == BidiRLI || (c == BidiFSI && firstStrong(in, matchingPdi, i + 1, end) == 1);
+            int nl = nextLevel(top.level, rtl);
+            if (nl <= kMaxDepth && !overflowIsolate && !overflowEmbedding) {
+                validIsolate++;
+                stack[++sp] = {static_cast<uint8_t>(nl), BidiON, true};
+            } else {
+                overflowIsolate++;
+            }
+            break;
+        }
+        case BidiPDI:
+            if (overflowIsolate) {
+                overflowIsolate--;
+            } else if (validIsolate) {
+                overflowEmbedding = 0;
+                while (!stack[sp].isolate) sp--;
+                sp--;
+                validIsolate--;
+            }
+            levels[i] = stack[sp].level;
+            if (stack[sp].override != BidiON) t[i] = stack[sp].override;
+            break;
+        case BidiPDF:
+            if (!overflowIsolate) {
+                if (overflowEmbedding) overflowEmbedding--;
+                else if (!top.isolate && sp > 0) sp--;
+            }
+            levels[i] = stack[sp].level;
+            t[i] = BidiBN;
+            break;
+        case BidiB:
+            levels[i] = static_cast<uint8_t>(para);
+            break;
+        case BidiBN:
+            levels[i] = top.level;
+            break;
+        default:
+            levels[i] = top.level;
+            if (top.override != BidiON) t[i] = top.override;
+            break;
+        }
+    }
+
+    // X10: level runs over the characters X9 kept, chained across isolates
+    std::vector<std::vector<uint32_t>> runs;
+    std::vector<int32_t> runStartingAt(n, -1);
+    for (size_t i = 0; i < n; i++) {
+        if (t[i] == BidiBN) continue;
+        if (runs.empty() || levels[runs.back().back()] != levels[i]) {
+            runStartingAt[i] = static_cast<int32_t>(runs.size());
+            runs.emplace_back();
+        }
+        runs.back().push_back(static_cast<uint32_t>(i));
+    }
+
+    auto neighbourLevel = [&](int64_t i, int step) -> int {
+        for (i += step; i >= 0 && i < static_cast<int64_t>(n); i += step) {
+            if (t[i] != BidiBN) return levels[i];
+        }
+        return para;
+    };
+
+    std::vector<uint32_t> seq;
+    for (const auto& run : runs) {
+        if (matchedPdi[run.front()]) continue;  // Continues an earlier sequence
+        seq = run;
+        for (;;) {
+            uint32_t last = seq.back();
+            if (!isIsolateInitiator(in[last]) || matchingPdi[last] < 0) break;
+            int32_t next = runStartingAt[matchingPdi[last]];
+            if (next < 0) break;
+            seq.insert(seq.end(), runs[next].begin(), runs[next].end());
+        }
+
+        int level = levels[seq.front()];
+        int before = std::max(level, neighbourLevel(seq.front(), -1));
+        uint32_t last = seq.back();
+        int after = std::max(level, isIsolateInitiator(in[last]) ? para : neighbourLevel(last, 1));
+        resolveSequence(seq, t.data(), levels, (before & 1) ? BidiR : BidiL, (after & 1) ? BidiR : BidiL);
+    }
+
+    // Removed characters take their neighbour's level (they are not drawn)
+    for (size_t i = 0; i < n; i++) {
+        if (t[i] == BidiBN) levels[i] = static_cast<uint8_t>(i ? levels[i - 1] : para);
+    }
+    return para;
+}
+
+static bool isWhitespaceLike(BidiClass c) {
+    return c == BidiWS || isIsolateInitiator(c) || c == BidiPDI || c == BidiBN ||
+           (c >= BidiLRE && c <= BidiPDF);
+}
+
+void bidiReorderLine(const BidiClass* classes, const uint8_t* levels, size_t start, size_t end,
+                     int paragraphLevel, uint32_t* order) {
+    size_t n = end - start;
+    std::vector<uint8_t> lv(levels + start, levels + end);
+
+    // L1: separators and trailing whitespace go back to the paragraph level
+    bool trailing = true;
+    for (size_t k = n; k-- > 0;) {
+        BidiClass c = classes[start + k];
+        if (c == BidiS || c == BidiB) {
+            lv[k] = static_cast<uint8_t>(paragraphLevel);
+            trailing = true;
+        } else if (trailing && isWhitespaceLike(c)) {
+            lv[k] = static_cast<uint8_t>(paragraphLevel);
+        } else {
+            trailing = false;
+        }
+    }
+
+    // L2: reverse every run at or above each level, highest first
+    uint8_t highest = 0, lowestOdd = 255;
+    for (size_t k = 0; k < n; k++) {
+        order[k] = static_cast<uint32_t>(start + k);
+        highest = std::max(highest, lv[k]);
+        if (lv[k] & 1) lowestOdd = std::min(lowestOdd, lv[k]);
+    }
+    for (int level = highest; level >= lowestOdd && level > 0; level--) {
+        for (size_t k = 0; k < n;) {
+            if (lv[k] < level) {
+                k++;
+                continue;
+            }
+            size_t j = k;
+            while (j < n && lv[j] >= level) j++;
+            std::reverse(order + k, order + j);
+            std::reverse(lv.begin() + k, lv.begin() + j);
+            k = j;
+        }
+    }
+}
+
+}
@@ -0,0 +1,14 @@
+#include "locale.hpp"
+
+namespace palisade::gui::locale {
+
+// Active table, then the built-in English strings
+const char* lookup(StringKey id) {
+    if (const StringTable* t = activeTable()) {
+        if (const char* s = t->find(id)) return s;
+    }
+    const char* s = fallbackLookup(id);
+    return s ? s : "UNKNOWN";
+}
+
+}
@@ -0,0 +1,75 @@
+#include "string_table.hpp"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace palisade::gui::locale {
+
+StringTable::~StringTable() {
+    close();
+}
+
+// Maps the file and validates every offset once, so find() needs no checks
+bool StringTable::open(const char* path) {
+    close();
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(TableHeader))) {
+        ::close(fd);
+        return false;
+    }
+    void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) return false;
+
+    base = static_cast<const uint8_t*>(p);
+    mapped = static_cast<size_t>(st.st_size);
+    const TableHeader* h = reinterpret_cast<const TableHeader*>(base);
+    uint64_t seedsEnd = h->seedsOffset + static_cast<uint64_t>(h->buckets) * sizeof(uint32_t);
+    uint64_t entriesEnd = h->entriesOffset + static_cast<uint64_t>(h->count) * sizeof(TableEntry);
+    uint64_t stringsEnd = static_cast<uint64_t>(h->stringsOffset) + h->stringsSize;
+    bool valid = h->magic == kTableMagic && h->version == kTableVersion && h->count && h->buckets &&
+                 h->seedsOffset % 4 == 0 && h->entriesOffset % 8 == 0 &&
+                 seedsEnd <= mapped && entriesEnd <= mapped && stringsEnd <= mapped &&
+                 h->stringsSize && base[stringsEnd - 1] == '\0' && memchr(h->language, '\0', sizeof(h->language));
+    if (valid) {
+        const TableEntry* e = reinterpret_cast<const TableEntry*>(base + h->entriesOffset);
+        for (uint32_t i = 0; i < h->count && valid; i++) {
+            valid = static_cast<uint64_t>(e[i].offset) + e[i].length < h->stringsSize &&
+                    base[h->stringsOffset + e[i].offset + e[i].length] == '\0';
+        }
+    }
+    if (!valid) {
+        close();
+        return false;
+    }
+
+    header = h;
+    seeds = reinterpret_cast<const uint32_t*>(base + h->seedsOffset);
+    entries = reinterpret_cast<const TableEntry*>(base + h->entriesOffset);
+    strings = reinterpret_cast<const char*>(base + h->stringsOffset);
+    return true;
+}
+
+void StringTable::close() {
+    if (base) munmap(const_cast<uint8_t*>(base), mapped);
+    base = nullptr;
+    mapped = 0;
+    header = nullptr;
+    seeds = nullptr;
+    entries = nullptr;
+    strings = nullptr;
+}
+
+// Two hashes and one compare; the stored key rejects ids not in the table
+const char* StringTable::find(StringKey key) const {
+    if (!header) return nullptr;
+    uint32_t seed = seeds[bucketFor(key, header->buckets)];
+    const TableEntry& e = entries[slotFor(key, seed, header->count)];
+    return e.key == key ? strings + e.offset : nullptr;
+}
+
+}
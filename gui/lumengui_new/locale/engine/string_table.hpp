@@ -0,0 +1,80 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+namespace palisade::gui::locale {
+
+// String ids are the FNV-1a hash of the catalog key, so stringId("common.ok")
+// folds to a constant and is the same in every language table
+using StringKey = uint64_t;
+
+constexpr StringKey stringId(const char* key) {
+    uint64_t h = 1469598103934665603ull;
+    while (*key) {
+        h ^= static_cast<uint8_t>(*key++);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// Slot of a key inside its bucket's displacement (CHD-style perfect hash)
+constexpr uint32_t slotFor(StringKey key, uint32_t seed, uint32_t count) {
+    uint64_t h = key ^ (static_cast<uint64_t>(seed) * 0x9E3779B97F4A7C15ull);
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    return static_cast<uint32_t>(h % count);
+}
+
+constexpr uint32_t bucketFor(StringKey key, uint32_t buckets) {
+    return static_cast<uint32_t>((key >> 32) % buckets);
+}
+
+// .lstb layout: header, seeds[buckets], entries[count], NUL-terminated strings.
+// All offsets are from the start of the file; integers are little endian.
+constexpr uint32_t kTableMagic = 0x4254534C;  // "LSTB"
+constexpr uint32_t kTableVersion = 1;
+
+struct TableHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t buckets;
+    uint32_t seedsOffset;
+    uint32_t entriesOffset;
+    uint32_t stringsOffset;
+    uint32_t stringsSize;
+    char language[16];
+};
+
+struct TableEntry {
+    StringKey key;
+    uint32_t offset;    // Into the strings blob
+    uint32_t length;
+};
+
+// Read-only view of a compiled table, mapped from disk (zero copy)
+class StringTable {
+public:
+    StringTable() = default;
+    ~StringTable();
+    StringTable(const StringTable&) = delete;
+    StringTable& operator=(const StringTable&) = delete;
+
+    bool open(const char* path);
+    void close();
+
+    const char* find(StringKey key) const;  // nullptr when absent
+    const char* language() const { return header ? header->language : ""; }
+    uint32_t size() const { return header ? header->count : 0; }
+
+private:
+    const uint8_t* base = nullptr;
+    size_t mapped = 0;
+    const TableHeader* header = nullptr;
+    const uint32_t* seeds = nullptr;
+    const TableEntry* entries = nullptr;
+    const char* strings = nullptr;
+};
+
+}
@@ -0,0 +1,207 @@
+#include "text_layout.hpp"
+#include <string.h>
+#include <algorithm>
+
+namespace palisade::gui::locale {
+
+// Malformed sequences decode to U+FFFD; CR before LF is dropped
+static void decodeUtf8(std::string_view s, std::vector<uint32_t>& out) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(s.data());
+    const uint8_t* end = p + s.size();
+    while (p < end) {
+        uint32_t c = *p++;
+        int extra = c < 0x80 ? 0 : (c >> 5) == 0x6 ? 1 : (c >> 4) == 0xE ? 2 : (c >> 3) == 0x1E ? 3 : -1;
+        if (extra < 0) {
+            out.push_back(0xFFFD);
+            continue;
+        }
+        c &= extra == 0 ? 0x7F : extra == 1 ? 0x1F : extra == 2 ? 0x0F : 0x07;
+        bool ok = true;
+        for (int k = 0; k < extra; k++) {
+            if (p >= end || (*p & 0xC0) != 0x80) {
+                ok = false;
+                break;
+            }
+            c = (c << 6) | (*p++ & 0x3F);
+        }
+        if (!ok || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF)) c = 0xFFFD;
+        if (c == '\r' && p < end && *p == '\n') continue;
+        out.push_back(c);
+    }
+}
+
+static bool isIdeographic(uint32_t c) {
+    return (c >= 0x2E80 && c <= 0x9FFF) || (c >= 0xAC00 && c <= 0xD7AF) || (c >= 0xF900 && c <= 0xFAFF) ||
+           (c >= 0xFF00 && c <= 0xFF60) || (c >= 0x20000 && c <= 0x3FFFF);
+}
+
+static bool isSpace(uint32_t c) {
+    return c == ' ' || c == '\t' || c == 0x3000 || (c >= 0x2000 && c <= 0x200A && c != 0x2007) || c == 0x205F;
+}
+
+// Never break before these (UAX #14 CL/CP/EX/IS classes, roughly)
+static bool isClosing(uint32_t c) {
+    return strchr(",.;:!?)]}", static_cast<int>(c < 0x80 ? c : 1)) != nullptr || c == 0xBB || c == 0x203A ||
+           c == 0x3001 || c == 0x3002 || c == 0x3009 || c == 0x300B || c == 0x300D || c == 0x300F ||
+           c == 0x3011 || c == 0xFF09 || c == 0xFF0C || c == 0xFF0E || c == 0xFF1A || c == 0xFF1B ||
+           c == 0x060C || c == 0x061F;
+}
+
+static bool isOpening(uint32_t c) {
+    return c == '(' || c == '[' || c == '{' || c == 0xAB || c == 0x3008 || c == 0x300A || c == 0x300C ||
+           c == 0x300E || c == 0x3010 || c == 0xFF08;
+}
+
+// Break opportunity between cps[i] and cps[i + 1] (UAX #14 subset: spaces,
+// hyphens, ZWSP, ideographs; never before closing punctuation or marks)
+static bool canBreakAfter(const std::vector<uint32_t>& cps, const BidiClass* classes, size_t i, size_t lineStart) {
+    uint32_t a = cps[i], b = cps[i + 1];
+    if (classes[i + 1] == BidiNSM || b == 0x200D || isClosing(b) || isSpace(b)) return false;
+    if (a == 0x200B || isSpace(a)) return true;
+    if ((a == '-' || a == 0x2010 || a == 0x2013) && i > lineStart && !isSpace(cps[i - 1])) return true;
+    if (isOpening(a)) return false;
+    return isIdeographic(a) || isIdeographic(b);
+}
+
+static float defaultAdvance(uint32_t cp, float scale, void*) {
+    return (isIdeographic(cp) ? 18.0f : 9.0f) * scale;
+}
+
+static bool isInvisible(BidiClass c) {
+    return c == BidiBN || c == BidiB || (c >= BidiLRE && c <= BidiPDI);
+}
+
+std::shared_ptr<const TextBlock> TextLayout::build(std::string_view utf8, float width, float scale) const {
+    auto block = std::make_shared<TextBlock>();
+    std::vector<uint32_t> cps;
+    decodeUtf8(utf8, cps);
+    size_t n = cps.size();
+    std::vector<BidiClass> classes(n);
+    std::vector<uint8_t> levels(n);
+    std::vector<float> adv(n);
+    auto advance = metrics.advance ? metrics.advance : defaultAdvance;
+    for (size_t i = 0; i < n; i++) {
+        classes[i] = bidiClass(cps[i]);
+        bool zero = classes[i] == BidiNSM || isInvisible(classes[i]);
+        adv[i] = zero ? 0.0f : advance(cps[i], scale, metrics.user);
+    }
+
+    float lineHeight = metrics.lineHeight * scale;
+    std::vector<uint32_t> order;
+    auto emitLine = [&](size_t start, size_t end, int para) {
+        TextLine line{static_cast<uint32_t>(block->glyphs.size()), 0, 0.0f, block->lines.size() * lineHeight};
+        size_t visibleEnd = end;
+        while (visibleEnd > start && (isSpace(cps[visibleEnd - 1]) || isInvisible(classes[visibleEnd - 1]))) visibleEnd--;
+        for (size_t i = start; i < visibleEnd; i++) line.width += adv[i];
+
+        order.resize(end - start);
+        if (end > start) bidiReorderLine(classes.data(), levels.data(), start, end, para, order.data());
+        float x = 0.0f;
+        for (uint32_t idx : order) {
+            if (isInvisible(classes[idx])) continue;
+            uint32_t cp = (levels[idx] & 1) ? bidiMirror(cps[idx]) : cps[idx];
+            block->glyphs.push_back({cp, idx, x});
+            x += adv[idx];
+        }
+        line.glyphCount = static_cast<uint32_t>(block->glyphs.size()) - line.firstGlyph;
+        block->width = std::max(block->width, line.width);
+        block->lines.push_back(line);
+    };
+
+    size_t ps = 0;
+    int para = 0;
+    do {
+        size_t pe = ps;
+        while (pe < n && classes[pe] != BidiB) pe++;
+        size_t contentEnd = pe;
+        if (pe < n) pe++;  // The separator belongs to its paragraph
+
+        para = pe > ps ? bidiResolve(classes.data() + ps, pe - ps, -1, levels.data() + ps) : 0;
+        if (ps == 0) block->rtl = para & 1;
+
+        // Greedy fill; whitespace may hang past the edge, a word that does
+        // not fit on an empty line is split between codepoints
+        size_t lineStart = ps;
+        if (lineStart == contentEnd) emitLine(ps, contentEnd, para);
+        while (lineStart < contentEnd) {
+            float w = 0.0f;
+            size_t lastBreak = 0, i = lineStart;
+            for (; i < contentEnd; i++) {
+                if (!isSpace(cps[i]) && i > lineStart && w + adv[i] > width) break;
+                w += adv[i];
+                if (i + 1 < contentEnd && canBreakAfter(cps, classes.data(), i, lineStart)) lastBreak = i + 1;
+            }
+            size_t lineEnd = contentEnd;
+            if (i < contentEnd) {
+                if (lastBreak > lineStart) {
+                    lineEnd = lastBreak;
+                } else {
+                    lineEnd = i;
+                    while (lineEnd > lineStart + 1 && classes[lineEnd] == BidiNSM) lineEnd--;
+                }
+            }
+            emitLine(lineStart, lineEnd, para);
+            lineStart = lineEnd;
+        }
+        ps = pe;
+    } while (ps < n);
+    if (n && classes[n - 1] == BidiB) emitLine(n, n, para);  // Text ends with a newline
+
+    block->height = block->lines.size() * lineHeight;
+    return block;
+}
+
+TextLayout::TextLayout(TextMetrics m, size_t cap) : metrics(m), capacity(cap ? cap : 1) {}
+
+static uint64_t layoutHash(std::string_view s, float width, float scale) {
+    uint64_t h = 1469598103934665603ull;
+    for (char c : s) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 1099511628211ull;
+    }
+    uint32_t bits[2];
+    memcpy(&bits[0], &width, 4);
+    memcpy(&bits[1], &scale, 4);
+    h ^= (static_cast<uint64_t>(bits[0]) << 32 | bits[1]) * 0x9E3779B97F4A7C15ull;
+    return h;
+}
+
+// Hit: one hash over the text and a compare; the block is shared, not copied
+std::shared_ptr<const TextBlock> TextLayout::layout(std::string_view utf8, float width, float scale) {
+    uint64_t h = layoutHash(utf8, width, scale);
+    auto it = index.find(h);
+    if (it != index.end()) {
+        Entry& e = *it->second;
+        if (e.width == width && e.scale == scale && e.text == utf8) {
+            lru.splice(lru.begin(), lru, it->second);
+            stats_.hits++;
+            return e.block;
+        }
+        lru.erase(it->second);  // Hash collision: replace
+        index.erase(it);
+    }
+
+    stats_.misses++;
+    auto block = build(utf8, width, scale);
+    lru.push_front(Entry{h, std::string(utf8), width, scale, block});
+    index[h] = lru.begin();
+    if (lru.size() > capacity) {
+        index.erase(lru.back().hash);
+        lru.pop_back();
+        stats_.evictions++;
+    }
+    return block;
+}
+
+void TextLayout::clear() {
+    lru.clear();
+    index.clear();
+}
+
+// Shared UI-thread instance
+TextLayout& textLayout() {
+    static TextLayout layout;
+    return layout;
+}
+
+}
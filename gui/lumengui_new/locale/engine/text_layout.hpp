@@ -0,0 +1,100 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace palisade::gui::locale {
+
+// Unicode bidi classes (UAX #9, table 4)
+enum BidiClass : uint8_t {
+    BidiL, BidiR, BidiAL,
+    BidiEN, BidiES, BidiET, BidiAN, BidiCS, BidiNSM, BidiBN,
+    BidiB, BidiS, BidiWS, BidiON,
+    BidiLRE, BidiLRO, BidiRLE, BidiRLO, BidiPDF,
+    BidiLRI, BidiRLI, BidiFSI, BidiPDI,
+};
+
+BidiClass bidiClass(uint32_t cp);   // Range table covering the scripts the UI ships
+uint32_t bidiMirror(uint32_t cp);   // Mirrored glyph, or cp itself
+
+// Resolves embedding levels for one paragraph (no B inside except at the
+// end). baseLevel -1 picks the level from the first strong character (P2/P3).
+// Returns the paragraph level.
+int bidiResolve(const BidiClass* classes, size_t n, int baseLevel, uint8_t* levels);
+
+// Visual order of [start, end) after L1 and L2; order receives logical indices
+void bidiReorderLine(const BidiClass* classes, const uint8_t* levels, size_t start, size_t end,
+                     int paragraphLevel, uint32_t* order);
+
+struct TextMetrics {
+    float (*advance)(uint32_t cp, float scale, void* user);   // nullptr: 9 px monospace
+    void* user;
+    float lineHeight;   // At scale 1
+};
+
+struct PlacedGlyph {
+    uint32_t cp;        // Mirrored where the level is RTL
+    uint32_t cluster;   // Logical codepoint index
+    float x;            // From the line's left edge
+};
+
+struct TextLine {
+    uint32_t firstGlyph;
+    uint32_t glyphCount;
+    float width;        // Excluding trailing whitespace
+    float y;            // Top of the line
+};
+
+// A laid-out, immutable paragraph block. RTL paragraphs are meant to be
+// right-aligned: x + (boxWidth - line.width).
+struct TextBlock {
+    std::vector<PlacedGlyph> glyphs;    // Visual order, line by line
+    std::vector<TextLine> lines;
+    float width;
+    float height;
+    bool rtl;                           // Base direction of the first paragraph
+};
+
+struct TextLayoutStats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+};
+
+// Bidi + line breaking with an LRU cache keyed by (text, width, scale), so
+// drawing the same string every frame is a hash lookup
+class TextLayout {
+public:
+    explicit TextLayout(TextMetrics metrics = {nullptr, nullptr, 25.0f}, size_t capacity = 256);
+
+    std::shared_ptr<const TextBlock> layout(std::string_view utf8, float width, float scale);
+    void clear();
+    const TextLayoutStats& stats() const { return stats_; }
+
+private:
+    struct Entry {
+        uint64_t hash;
+        std::string text;
+        float width;
+        float scale;
+        std::shared_ptr<const TextBlock> block;
+    };
+    using Lru = std::list<Entry>;
+
+    TextMetrics metrics;
+    size_t capacity;
+    Lru lru;
+    std::unordered_map<uint64_t, Lru::iterator> index;    // Hash -> entry; text compared on hit
+    TextLayoutStats stats_{};
+
+    std::shared_ptr<const TextBlock> build(std::string_view utf8, float width, float scale) const;
+};
+
+TextLayout& textLayout();
+
+}
@@ -0,0 +1,32 @@
+#include "../engine/locale.hpp"
+
+namespace palisade::gui::lang::en_us {
+const char* ok();
+const char* cancel();
+const char* system();
+const char* error();
+}
+
+namespace palisade::gui::locale {
+
+// Compiled-in English, used before any table is mapped or for keys a
+// translation lacks
+const char* fallbackLookup(StringKey id) {
+    namespace en = lang::en_us;
+    struct Entry {
+        StringKey id;
+        const char* (*text)();
+    };
+    static constexpr Entry entries[] = {
+        {stringId("common.ok"), en::ok},
+        {stringId("common.cancel"), en::cancel},
+        {stringId("system.title"), en::system},
+        {stringId("error.generic"), en::error},
+    };
+    for (const Entry& e : entries) {
+        if (e.id == id) return e.text();
+    }
+    return nullptr;
+}
+
+}
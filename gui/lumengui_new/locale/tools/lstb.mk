@@ -0,0 +1,22 @@
+# Catalog rule for the product build: include this file and depend on
+# locale-tables. Each languages/<name>/<code>.strings becomes
+# $(LSTB_OUT)/<code>.lstb, the file setLanguage(<code>) maps at runtime
+# (see setTableDirectory()).
+LOCALE_DIR := $(patsubst %/tools/,%,$(dir $(lastword $(MAKEFILE_LIST))))
+LSTB_OUT ?= locale
+LSTB_COMPILE := $(LSTB_OUT)/.tools/lstb_compile
+LSTB_SOURCES := $(wildcard $(LOCALE_DIR)/languages/*/*.strings)
+LSTB_TABLES := $(patsubst %.strings,$(LSTB_OUT)/%.lstb,$(notdir $(LSTB_SOURCES)))
+
+vpath %.strings $(sort $(dir $(LSTB_SOURCES)))
+
+$(LSTB_COMPILE): $(LOCALE_DIR)/tools/lstb_compile.cpp $(LOCALE_DIR)/engine/string_table.hpp
+	@mkdir -p $(dir $@)
+	$(CXX) -std=c++17 -O2 -o $@ $<
+
+$(LSTB_OUT)/%.lstb: %.strings $(LSTB_COMPILE)
+	$(LSTB_COMPILE) $* $< $@
+
+locale-tables: $(LSTB_TABLES)
+
+.PHONY: locale-tables
@@ -0,0 +1,168 @@
+// Build step: compiles a .strings catalog into a .lstb table for StringTable.
+//   lstb_compile <language> <input.strings> <output.lstb>
+// tools/lstb.mk holds the make rule for every languages/*/*.strings.
+#include "../engine/string_table.hpp"
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace palisade::gui::locale;
+
+struct Item {
+    std::string key;
+    std::string value;
+    StringKey id;
+};
+
+static std::string trim(const std::string& s) {
+    size_t b = s.find_first_not_of(" \t\r");
+    size_t e = s.find_last_not_of(" \t\r");
+    return b == std::string::npos ? std::string() : s.substr(b, e - b + 1);
+}
+
+static std::string unescape(const std::string& s) {
+    std::string out;
+    for (size_t i = 0; i < s.size(); i++) {
+        if (s[i] == '\\' && i + 1 < s.size()) {
+            char c = s[++i];
+            out += c == 'n' ? '\n' : c == 't' ? '\t' : c;
+        } else {
+            out += s[i];
+        }
+    }
+    return out;
+}
+
+static bool parse(const char* path, std::vector<Item>& items) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "lstb_compile: cannot open %s\n", path);
+        return false;
+    }
+    char buf[4096];
+    int line = 0;
+    bool ok = true;
+    while (fgets(buf, sizeof(buf), f)) {
+        line++;
+        std::string s = trim(std::string(buf, strcspn(buf, "\n")));
+        if (s.empty() || s[0] == '#') continue;
+        size_t eq = s.find('=');
+        if (eq == std::string::npos) {
+            fprintf(stderr, "%s:%d: expected key = value\n", path, line);
+            ok = false;
+            continue;
+        }
+        Item it{trim(s.substr(0, eq)), unescape(trim(s.substr(eq + 1))), 0};
+        if (it.key.empty() || it.value.find('\0') != std::string::npos) {
+            fprintf(stderr, "%s:%d: invalid entry\n", path, line);
+            ok = false;
+            continue;
+        }
+        it.id = stringId(it.key.c_str());
+        items.push_back(it);
+    }
+    fclose(f);
+    return ok;
+}
+
+// Hash and displace: buckets are placed largest first, each trying seeds
+// until all of its keys land in free slots
+static bool buildHash(const std::vector<Item>& items, uint32_t buckets,
+                      std::vector<uint32_t>& seeds, std::vector<int32_t>& slots) {
+    uint32_t count = static_cast<uint32_t>(items.size());
+    std::vector<std::vector<uint32_t>> groups(buckets);
+    for (uint32_t i = 0; i < count; i++) groups[bucketFor(items[i].id, buckets)].push_back(i);
+    std::vector<uint32_t> order(buckets);
+    for (uint32_t b = 0; b < buckets; b++) order[b] = b;
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return groups[a].size() > groups[b].size(); });
+
+    seeds.assign(buckets, 0);
+    slots.assign(count, -1);
+    for (uint32_t b : order) {
+        if (groups[b].empty()) break;
+        bool placed = false;
+        for (uint32_t seed = 0; seed < 1u << 20 && !placed; seed++) {
+            std::vector<uint32_t> taken;
+            placed = true;
+            for (uint32_t i : groups[b]) {
+                uint32_t s = slotFor(items[i].id, seed, count);
+                if (slots[s] >= 0 || std::find(taken.begin(), taken.end(), s) != taken.end()) {
+                    placed = false;
+                    break;
+                }
+                taken.push_back(s);
+            }
+            if (placed) {
+                for (size_t k = 0; k < taken.size(); k++) slots[taken[k]] = static_cast<int32_t>(groups[b][k]);
+                seeds[b] = seed;
+            }
+        }
+        if (!placed) return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 4 || strlen(argv[1]) >= sizeof(TableHeader::language)) {
+        fprintf(stderr, "usage: lstb_compile <language> <input.strings> <output.lstb>\n");
+        return 2;
+    }
+    std::vector<Item> items;
+    if (!parse(argv[2], items)) return 1;
+    if (items.empty()) {
+        fprintf(stderr, "lstb_compile: %s has no strings\n", argv[2]);
+        return 1;
+    }
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) { return a.id < b.id; });
+    for (size_t i = 1; i < items.size(); i++) {
+        if (items[i].id == items[i - 1].id) {
+            fprintf(stderr, "lstb_compile: duplicate or colliding keys '%s' and '%s'\n",
+                    items[i - 1].key.c_str(), items[i].key.c_str());
+            return 1;
+        }
+    }
+
+    uint32_t count = static_cast<uint32_t>(items.size());
+    uint32_t buckets = std::max(1u, count / 4);
+    std::vector<uint32_t> seeds;
+    std::vector<int32_t> slots;
+    while (!buildHash(items, buckets, seeds, slots)) buckets *= 2;
+
+    std::string blob;
+    std::vector<TableEntry> entries(count);
+    for (uint32_t s = 0; s < count; s++) {
+        const Item& it = items[slots[s]];
+        entries[s] = {it.id, static_cast<uint32_t>(blob.size()), static_cast<uint32_t>(it.value.size())};
+        blob += it.value;
+        blob += '\0';
+    }
+
+    TableHeader h{};
+    h.magic = kTableMagic;
+    h.version = kTableVersion;
+    h.count = count;
+    h.buckets = buckets;
+    h.seedsOffset = sizeof(TableHeader);
+    h.entriesOffset = (h.seedsOffset + buckets * 4 + 7) & ~7u;
+    h.stringsOffset = h.entriesOffset + count * static_cast<uint32_t>(sizeof(TableEntry));
+    h.stringsSize = static_cast<uint32_t>(blob.size());
+    memcpy(h.language, argv[1], strlen(argv[1]));
+
+    std::vector<uint8_t> out(h.stringsOffset + blob.size(), 0);
+    memcpy(out.data(), &h, sizeof(h));
+    memcpy(out.data() + h.seedsOffset, seeds.data(), buckets * 4);
+    memcpy(out.data() + h.entriesOffset, entries.data(), count * sizeof(TableEntry));
+    memcpy(out.data() + h.stringsOffset, blob.data(), blob.size());
+
+    FILE* f = fopen(argv[3], "wb");
+    bool written = f && fwrite(out.data(), 1, out.size(), f) == out.size();
+    if (f && fclose(f) != 0) written = false;
+    if (!written) {
+        fprintf(stderr, "lstb_compile: cannot write %s\n", argv[3]);
+        return 1;
+    }
+    printf("%s: %u strings, %u buckets, %zu bytes\n", argv[3], count, buckets, out.size());
+    return 0;
+}
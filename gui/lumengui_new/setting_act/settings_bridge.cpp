@@ -0,0 +1,135 @@
+#include "settings_registry.hpp"
+#include "../gui_mod/include/settings.h"
+#include "../gui_mod/include/gui_module.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace palisade::gui::settings {
+
+namespace {
+
+constexpr const char* kDefaultPath = "/data/system/gui_settings.bin";
+
+// The store may still call forward() once after unsubscribe(), so the
+// callback is read atomically and a slot is only reused once the calls
+// already in flight have left it
+struct Watch {
+    std::atomic<void (*)(int key, void* user)> fn{nullptr};
+    std::atomic<void*> user{nullptr};
+    std::atomic<int> busy{0};   // forward() calls in progress, any thread
+    int id = -1;                // Store listener (watchMutex)
+    bool used = false;          // Taken, or still draining after unwatch (watchMutex)
+};
+
+std::mutex watchMutex;
+Watch watches[SettingsStore::kMaxListeners];
+thread_local int dispatching[SettingsStore::kMaxListeners];  // This thread's calls per watch
+int postId = -1;                // The GUI_EVENT_SETTING listener while open
+
+void post(Setting s, double, void*) {
+    gui_event_push(GUI_EVENT_SETTING, static_cast<int>(s));
+}
+
+void forward(Setting s, double, void* user) {
+    Watch* w = static_cast<Watch*>(user);
+    int slot = static_cast<int>(w - watches);
+    w->busy.fetch_add(1);
+    if (auto fn = w->fn.load()) {
+        dispatching[slot]++;
+        fn(static_cast<int>(s), w->user.load());
+        dispatching[slot]--;
+    }
+    w->busy.fetch_sub(1);
+}
+
+bool validKey(int key) {
+    return key >= 0 && key < kSettingCount;
+}
+
+}
+
+}
+
+using namespace palisade::gui::settings;
+
+static_assert(SETTING_COUNT == kSettingCount, "settings.h out of sync with Setting");
+
+extern "C" int settings_open(const char* path) {
+    SettingsStore& s = store();
+    if (s.isOpen()) return 0;
+    if (!s.open(path ? path : kDefaultPath)) return -1;
+    postId = s.subscribe(~0ULL, post);
+    return 0;
+}
+
+// The next open subscribes again, so the old listener must go
+extern "C" void settings_close(void) {
+    if (postId >= 0) store().unsubscribe(postId);
+    postId = -1;
+    store().close();
+}
+
+extern "C" float setting_get_f(int key) {
+    return validKey(key) ? store().getFloat(static_cast<Setting>(key)) : 0.0f;
+}
+
+extern "C" int setting_get_i(int key) {
+    return validKey(key) ? store().getInt(static_cast<Setting>(key)) : 0;
+}
+
+extern "C" int setting_set_f(int key, float value) {
+    if (!validKey(key) || !store().isOpen()) return -1;
+    return store().set(static_cast<Setting>(key), value) ? 1 : 0;
+}
+
+extern "C" int setting_set_i(int key, int value) {
+    if (!validKey(key) || !store().isOpen()) return -1;
+    return store().set(static_cast<Setting>(key), value) ? 1 : 0;
+}
+
+// Returns the store's listener id; the watch it forwards through is ours
+extern "C" int settings_watch(uint64_t keys, void (*fn)(int key, void* user), void* user) {
+    if (!fn) return -1;
+    std::lock_guard<std::mutex> lk(watchMutex);
+    for (Watch& w : watches) {
+        if (w.used) continue;
+        w.user.store(user);
+        w.fn.store(fn);
+        w.id = store().subscribe(keys, forward, &w);
+        if (w.id < 0) {
+            w.fn.store(nullptr);
+            return -1;
+        }
+        w.used = true;
+        return w.id;
+    }
+    return -1;
+}
+
+// Returns once no other thread is inside the callback. Called from the
+// callback itself, the frames further up this thread are not waited for.
+extern "C" void settings_unwatch(int id) {
+    if (id < 0) return;
+    Watch* w = nullptr;
+    {
+        std::lock_guard<std::mutex> lk(watchMutex);
+        for (Watch& c : watches) {
+            if (c.used && c.id == id) {
+                w = &c;
+                break;
+            }
+        }
+        if (!w) return;
+        store().unsubscribe(id);
+        w->fn.store(nullptr);
+        w->id = -1;
+    }
+
+    // Not under watchMutex: a callback still running may watch or unwatch
+    int slot = static_cast<int>(w - watches);
+    while (w->busy.load() > dispatching[slot]) std::this_thread::yield();
+
+    std::lock_guard<std::mutex> lk(watchMutex);
+    w->used = false;
+}
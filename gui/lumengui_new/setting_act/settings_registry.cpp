@@ -0,0 +1,404 @@
+#include "settings_registry.hpp"
+#include "../core/timing/clock.hpp"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+namespace palisade::gui::settings {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x5445534C;     // "LSET"
+constexpr uint16_t kVersion = 1;
+
+// Fixed 4 KiB blocks, whatever the page size: live table, checkpoint A, B
+constexpr size_t kBlock = 4096;
+constexpr size_t kFileSize = 3 * kBlock;
+
+const SettingInfo kSettings[kSettingCount] = {
+    {"gui.anim_speed",    SettingType::Float, 1.5, 0.25, 4.0},
+    {"gui.low_power",     SettingType::Bool,  0.0, 0.0,  1.0},
+    {"gui.ui_brightness", SettingType::Float, 1.0, 0.05, 1.0},
+};
+
+uint64_t toBits(double v) {
+    uint64_t b;
+    memcpy(&b, &v, sizeof(b));
+    return b;
+}
+
+double fromBits(uint64_t b) {
+    double v;
+    memcpy(&v, &b, sizeof(v));
+    return v;
+}
+
+double normalize(const SettingInfo& info, double v) {
+    if (std::isnan(v)) return info.def;
+    if (info.type == SettingType::Bool) return v != 0.0 ? 1.0 : 0.0;
+    if (info.type == SettingType::Int) v = std::round(v);
+    return v < info.min ? info.min : (v > info.max ? info.max : v);
+}
+
+uint64_t checksum(const void* data, size_t size) {
+    uint64_t h = 1469598103934665603ULL;    // FNV-1a
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+}
+
+// Block 0. Values are double bits indexed by Setting, so only this build
+// reads it; the checkpoints are what survives across versions.
+struct SettingsStore::LiveTable {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+    std::atomic<uint32_t> seq;              // Odd while a batch is being written
+    std::atomic<uint32_t> generation;
+    std::atomic<uint64_t> values[kMaxSettings];
+};
+
+// Blocks 1 and 2. Entries are keyed by name: keys the build doesn't know are
+// dropped, new ones start at their default.
+struct SettingsStore::Checkpoint {
+    uint64_t checksum;                      // Over everything after it
+    uint32_t generation;                    // 0 = never written
+    uint32_t count;
+    struct Entry {
+        char name[24];
+        uint64_t bits;
+    } entries[kMaxSettings];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared mapping needs address-free atomics");
+static_assert(kSettingCount <= kMaxSettings, "raise kMaxSettings");
+
+const SettingInfo& settingInfo(Setting s) {
+    return kSettings[static_cast<int>(s)];
+}
+
+SettingsStore::SettingsStore() = default;
+
+SettingsStore::~SettingsStore() {
+    close();
+}
+
+SettingsStore::Checkpoint* SettingsStore::checkpoint(int i) const {
+    static_assert(sizeof(LiveTable) <= kBlock && sizeof(Checkpoint) <= kBlock, "block overflow");
+    return reinterpret_cast<Checkpoint*>(map + (1 + i) * kBlock);
+}
+
+bool SettingsStore::open(const char* path) {
+    if (isOpen()) return true;
+    long ps = sysconf(_SC_PAGESIZE);
+    pageSize = ps > 0 ? static_cast<size_t>(ps) : kBlock;
+    mapSize = (kFileSize + pageSize - 1) / pageSize * pageSize;
+
+    void* data = MAP_FAILED;
+    int fd = path ? ::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600) : -1;
+    if (fd >= 0) {
+        // Growing keeps the checkpoints; a short file just reads as invalid
+        struct stat st;
+        if (fstat(fd, &st) == 0 && (st.st_size >= static_cast<off_t>(mapSize) || ftruncate(fd, mapSize) == 0)) {
+            data = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+    }
+    persistent = data != MAP_FAILED;
+    if (!persistent) {
+        // Read-only or missing storage: keep working from memory
+        data = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (data == MAP_FAILED) return false;
+    }
+    map = static_cast<uint8_t*>(data);
+
+    restore();
+    stopping = false;
+    dirtySince = 0;
+    writer = std::thread(&SettingsStore::run, this);
+    return true;
+}
+
+// Newest valid checkpoint into the live table; anything left in block 0 by
+// a previous run is ignored, it may have been ahead of the disk
+void SettingsStore::restore() {
+    int best = -1;
+    for (int i = 0; i < 2; i++) {
+        const Checkpoint* c = checkpoint(i);
+        if (!c->generation || c->count > kMaxSettings) continue;
+        if (checksum(&c->generation, sizeof(Checkpoint) - sizeof(c->checksum)) != c->checksum) continue;
+        if (best < 0 || c->generation > checkpoint(best)->generation) best = i;
+    }
+
+    double values[kSettingCount];
+    for (int k = 0; k < kSettingCount; k++) values[k] = kSettings[k].def;
+    if (best >= 0) {
+        const Checkpoint* c = checkpoint(best);
+        for (uint32_t e = 0; e < c->count; e++) {
+            for (int k = 0; k < kSettingCount; k++) {
+                if (strncmp(c->entries[e].name, kSettings[k].name, sizeof(c->entries[e].name))) continue;
+                values[k] = normalize(kSettings[k], fromBits(c->entries[e].bits));
+                break;
+            }
+        }
+    }
+
+    auto* t = reinterpret_cast<LiveTable*>(map);
+    t->magic = kMagic;
+    t->version = kVersion;
+    t->count = kSettingCount;
+    t->seq.store(0, std::memory_order_relaxed);
+    loaded = best >= 0 ? checkpoint(best)->generation : 0;
+    t->generation.store(loaded, std::memory_order_relaxed);
+    for (int k = 0; k < kSettingCount; k++) t->values[k].store(toBits(values[k]), std::memory_order_relaxed);
+
+    written = loaded;
+    newest = best >= 0 ? best : 1;
+    live.store(t, std::memory_order_release);
+}
+
+// Readers outlive nothing: call once the render thread has stopped
+void SettingsStore::close() {
+    if (!isOpen()) return;
+    {
+        std::lock_guard<std::mutex> lk(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    writer.join();
+    writeBack();
+    live.store(nullptr, std::memory_order_release);
+    munmap(map, mapSize);
+    map = nullptr;
+}
+
+double SettingsStore::get(Setting s) const {
+    const LiveTable* t = live.load(std::memory_order_acquire);
+    int k = static_cast<int>(s);
+    if (!t) return kSettings[k].def;
+    // One slot is one atomic word: no retry loop needed for a single key
+    return fromBits(t->values[k].load(std::memory_order_relaxed));
+}
+
+SettingsSnapshot SettingsStore::snapshot() const {
+    SettingsSnapshot snap;
+    const LiveTable* t = live.load(std::memory_order_acquire);
+    if (!t) {
+        for (int k = 0; k < kSettingCount; k++) snap.values[k] = kSettings[k].def;
+        snap.generation = 0;
+        return snap;
+    }
+    for (;;) {
+        uint32_t s0 = t->seq.load(std::memory_order_acquire);
+        if (s0 & 1) continue;
+        for (int k = 0; k < kSettingCount; k++) snap.values[k] = fromBits(t->values[k].load(std::memory_order_acquire));
+        snap.generation = t->generation.load(std::memory_order_acquire);
+        if (t->seq.load(std::memory_order_relaxed) == s0) return snap;
+    }
+}
+
+bool SettingsStore::set(Setting s, double value) {
+    SettingChange c{s, value};
+    return apply(&c, 1);
+}
+
+bool SettingsStore::apply(const SettingChange* changes, int count) {
+    LiveTable* t = live.load(std::memory_order_acquire);
+    if (!t || !changes || count <= 0) return false;
+
+    double next[kSettingCount];
+    uint64_t changed = 0;
+    {
+        std::lock_guard<std::mutex> lk(writeMutex);
+        for (int k = 0; k < kSettingCount; k++) next[k] = fromBits(t->values[k].load(std::memory_order_relaxed));
+        for (int i = 0; i < count; i++) {
+            int k = static_cast<int>(changes[i].key);
+            if (k < 0 || k >= kSettingCount) continue;
+            double v = normalize(kSettings[k], changes[i].value);
+            if (v == next[k]) continue;
+            next[k] = v;
+            changed |= 1ULL << k;
+        }
+        if (!changed) return false;
+
+        uint32_t s = t->seq.load(std::memory_order_relaxed);
+        // Seqlock ordering as in gui_mod's state_write (gui_mod/core/gui_events.c)
+        t->seq.store(s + 1, std::memory_order_relaxed);
+        for (int k = 0; k < kSettingCount; k++) {
+            if (changed & (1ULL << k)) t->values[k].store(toBits(next[k]), std::memory_order_release);
+        }
+        t->generation.store(t->generation.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        t->seq.store(s + 2, std::memory_order_release);
+    }
+
+    for (int k = 0; k < kSettingCount; k++) {
+        if (!(changed & (1ULL << k))) continue;
+        for (auto& l : listeners) {
+            SettingsListener fn = l.fn.load(std::memory_order_acquire);
+            if (fn && (l.mask.load(std::memory_order_relaxed) & (1ULL << k))) {
+                fn(static_cast<Setting>(k), next[k], l.user.load(std::memory_order_relaxed));
+            }
+        }
+    }
+
+    // Due kWritebackDelayNs after the first unsaved write, so a slider
+    // dragged for seconds still reaches the disk at that rate
+    {
+        std::lock_guard<std::mutex> lk(wakeMutex);
+        if (!dirtySince) dirtySince = time::now();
+    }
+    wake.notify_one();
+    return true;
+}
+
+// Fill the older checkpoint, checksum last, and wait for it to reach the
+// disk. The other checkpoint is untouched until the next write-back.
+void SettingsStore::writeBack() {
+    std::lock_guard<std::mutex> lk(checkpointMutex);
+    SettingsSnapshot snap = snapshot();
+    if (snap.generation == written || !map) return;
+    if (persistent) {
+        int target = 1 - newest;
+        Checkpoint* c = checkpoint(target);
+        memset(c, 0, sizeof(*c));
+        c->generation = snap.generation;
+        c->count = kSettingCount;
+        for (int k = 0; k < kSettingCount; k++) {
+            strncpy(c->entries[k].name, kSettings[k].name, sizeof(c->entries[k].name) - 1);
+            c->entries[k].bits = toBits(snap.values[k]);
+        }
+        c->checksum = checksum(&c->generation, sizeof(Checkpoint) - sizeof(c->checksum));
+
+        size_t offset = (1 + target) * kBlock;
+        size_t start = offset / pageSize * pageSize;
+        msync(map + start, offset + kBlock - start, MS_SYNC);
+        newest = target;
+        checkpoints.fetch_add(1, std::memory_order_relaxed);
+    }
+    written = snap.generation;
+}
+
+void SettingsStore::flush() {
+    if (isOpen()) writeBack();
+}
+
+void SettingsStore::run() {
+    std::unique_lock<std::mutex> lk(wakeMutex);
+    while (!stopping) {
+        if (!dirtySince) {
+            wake.wait(lk);
+            continue;
+        }
+        uint64_t due = dirtySince + kWritebackDelayNs, now = time::now();
+        if (now < due) {
+            wake.wait_for(lk, std::chrono::nanoseconds(due - now));
+            continue;
+        }
+        dirtySince = 0;
+        lk.unlock();
+        writeBack();
+        lk.lock();
+    }
+}
+
+int SettingsStore::subscribe(uint64_t keyMask, SettingsListener fn, void* user) {
+    if (!fn) return -1;
+    std::lock_guard<std::mutex> lk(writeMutex);
+    for (int i = 0; i < kMaxListeners; i++) {
+        Listener& l = listeners[i];
+        if (l.fn.load(std::memory_order_relaxed)) continue;
+        l.mask.store(keyMask, std::memory_order_relaxed);
+        l.user.store(user, std::memory_order_relaxed);
+        l.fn.store(fn, std::memory_order_release);
+        return i;
+    }
+    return -1;
+}
+
+void SettingsStore::unsubscribe(int id) {
+    if (id < 0 || id >= kMaxListeners) return;
+    std::lock_guard<std::mutex> lk(writeMutex);
+    listeners[id].fn.store(nullptr, std::memory_order_release);
+}
+
+SettingsStats SettingsStore::stats() const {
+    SettingsStats st;
+    const LiveTable* t = live.load(std::memory_order_acquire);
+    st.generation = t ? t->generation.load(std::memory_order_relaxed) : 0;
+    st.checkpoints = checkpoints.load(std::memory_order_relaxed);
+    st.loadedGeneration = loaded;
+    st.persistent = persistent;
+    return st;
+}
+
+SettingsStore& store() {
+    static SettingsStore instance;
+    return instance;
+}
+
+int changeCount() {
+    SettingsStats st = store().stats();
+    return static_cast<int>(st.generation - st.loadedGeneration);
+}
+
+SettingsBenchResult benchmarkSettings(int readers, uint32_t writes) {
+    SettingsStore s;
+    s.open(nullptr);
+    std::atomic<bool> done{false};
+    std::atomic<int> started{0};
+    std::atomic<uint64_t> reads{0}, readNs{0};
+
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; r++) {
+        threads.emplace_back([&] {
+            // What a frame reads: a handful of keys, every time
+            started.fetch_add(1, std::memory_order_relaxed);
+            uint64_t n = 0, start = time::now();
+            double sink = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                for (int i = 0; i < 64; i++) {
+                    sink += s.get(Setting::AnimSpeed) + s.get(Setting::UiBrightness);
+                    sink += s.getBool(Setting::LowPower);
+                }
+                n += 64 * 3;
+            }
+            readNs.fetch_add(time::now() - start, std::memory_order_relaxed);
+            reads.fetch_add(n + (sink < 0), std::memory_order_relaxed);
+        });
+    }
+
+    while (started.load(std::memory_order_relaxed) < readers) std::this_thread::yield();
+    uint64_t start = time::now();
+    for (uint32_t i = 0; i < writes; i++) {
+        SettingChange batch[2] = {{Setting::AnimSpeed, 1.0 + (i % 8) * 0.25}, {Setting::LowPower, double(i & 1)}};
+        s.apply(batch, 2);
+    }
+    uint64_t writeNs = time::now() - start;
+    done.store(true, std::memory_order_relaxed);
+    for (auto& th : threads) th.join();
+
+    const int kSnapshots = 100000;
+    start = time::now();
+    uint32_t gen = 0;
+    for (int i = 0; i < kSnapshots; i++) gen += s.snapshot().generation;
+    uint64_t snapNs = time::now() - start;
+
+    SettingsBenchResult r;
+    r.reads = reads.load() + (gen == 1);
+    r.readNs = r.reads ? static_cast<double>(readNs.load()) / r.reads : 0.0;
+    r.snapshotNs = static_cast<double>(snapNs) / kSnapshots;
+    r.writeUs = writes ? writeNs / 1e3 / writes : 0.0;
+    return r;
+}
+
+}
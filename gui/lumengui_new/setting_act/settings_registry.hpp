@@ -0,0 +1,137 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace palisade::gui::settings {
+
+// Same order as enum setting_key (gui_mod/include/settings.h)
+enum class Setting : uint8_t { AnimSpeed, LowPower, UiBrightness, Count };
+constexpr int kSettingCount = static_cast<int>(Setting::Count);
+constexpr int kMaxSettings = 64;    // File format capacity
+
+enum class SettingType : uint8_t { Bool, Int, Float };
+
+struct SettingInfo {
+    const char* name;               // Key in the file, stable across builds
+    SettingType type;
+    double def, min, max;
+};
+
+const SettingInfo& settingInfo(Setting s);
+
+struct SettingChange {
+    Setting key;
+    double value;                   // Converted to the key's type and clamped
+};
+
+// Every key at one instant: no write lands between two of its reads
+struct SettingsSnapshot {
+    double values[kSettingCount];
+    uint32_t generation;
+
+    double get(Setting s) const { return values[static_cast<int>(s)]; }
+};
+
+// Called on the writing thread after the change is visible to readers.
+// May still run once after unsubscribe() if a write was in flight.
+using SettingsListener = void (*)(Setting s, double value, void* user);
+
+struct SettingsStats {
+    uint32_t generation;            // Committed writes that changed something
+    uint32_t checkpoints;           // Write-backs to the file
+    uint32_t loadedGeneration;      // Checkpoint restored at open (0 = defaults)
+    bool persistent;                // false: file unusable, values live in memory only
+};
+
+// Typed key-value store living in an mmapped file. The first 4 KiB hold the
+// live values, one atomic 64-bit slot per key, versioned by a seqlock that
+// covers multi-key writes: get() is a single load and never blocks, so the
+// render path can read settings every frame. Two checksummed checkpoint
+// blocks follow; a write-back fills the older one and msyncs it, and open()
+// restores the newest valid one, so a crash or power loss mid-write leaves
+// the previous checkpoint intact. Write-backs run on a thread, coalescing
+// writes for kWritebackDelayNs.
+class SettingsStore {
+public:
+    static constexpr uint64_t kWritebackDelayNs = 500000000ULL;
+    static constexpr int kMaxListeners = 16;
+
+    SettingsStore();
+    ~SettingsStore();
+
+    bool open(const char* path);    // Idempotent; nullptr path = memory only
+    void close();                   // Flushes
+    bool isOpen() const { return live.load(std::memory_order_acquire) != nullptr; }
+
+    // Lock-free, any thread. Before open() these return defaults.
+    double get(Setting s) const;
+    float getFloat(Setting s) const { return static_cast<float>(get(s)); }
+    int32_t getInt(Setting s) const { return static_cast<int32_t>(get(s)); }
+    bool getBool(Setting s) const { return get(s) != 0.0; }
+    SettingsSnapshot snapshot() const;
+
+    // Atomic for readers: all of a batch becomes visible together. Returns
+    // false when nothing changed (no listeners run, no write-back).
+    bool set(Setting s, double value);
+    bool apply(const SettingChange* changes, int count);
+    void flush();                   // Write back now and wait for the disk
+
+    int subscribe(uint64_t keyMask, SettingsListener fn, void* user = nullptr);  // Bit (1 << key); -1 when full
+    void unsubscribe(int id);
+
+    SettingsStats stats() const;
+
+private:
+    struct LiveTable;
+    struct Checkpoint;
+
+    struct Listener {
+        std::atomic<uint64_t> mask{0};
+        std::atomic<void*> user{nullptr};
+        std::atomic<SettingsListener> fn{nullptr};
+    };
+
+    uint8_t* map = nullptr;
+    size_t mapSize = 0;
+    size_t pageSize = 0;
+    bool persistent = false;
+    std::atomic<LiveTable*> live{nullptr};
+    Listener listeners[kMaxListeners];
+
+    std::mutex writeMutex;          // Serializes writers of the live table
+    std::mutex checkpointMutex;     // Write-back thread vs flush()
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::thread writer;
+    bool stopping = false;          // wakeMutex
+    uint64_t dirtySince = 0;        // wakeMutex; 0 = clean
+    uint32_t written = 0;           // checkpointMutex: generation on disk
+    int newest = 1;                 // checkpointMutex: checkpoint holding it
+    std::atomic<uint32_t> checkpoints{0};
+    uint32_t loaded = 0;
+
+    Checkpoint* checkpoint(int i) const;
+    void restore();
+    void writeBack();
+    void run();
+};
+
+SettingsStore& store();
+
+// Committed writes since start; the settings activity redraws when it moves
+int changeCount();
+
+struct SettingsBenchResult {
+    uint64_t reads;
+    double readNs;                  // Per get(), while a writer applies batches
+    double snapshotNs;
+    double writeUs;                 // Per apply() of two keys, listeners included
+};
+
+SettingsBenchResult benchmarkSettings(int readers, uint32_t writes);
+
+}
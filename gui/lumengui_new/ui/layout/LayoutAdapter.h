@@ -0,0 +1,17 @@
+#pragma once
+#include "DeviceProfile.h"
+
+struct LayoutMetrics {
+    int columns;
+    int dockSize;
+    bool gestureNav;
+    int margin = 0;         // Horizontal content margin (px)
+    int gutter = 0;         // Space between columns (px)
+    int columnWidth = 0;
+    int statusBar = 0;
+};
+
+class LayoutAdapter {
+public:
+    virtual LayoutMetrics metrics(const DeviceProfile&) = 0;
+};
@@ -0,0 +1,73 @@
+// PhoneLayout.cpp
+#include "PhoneLayout.h"
+#include "constraints/constraint_cache.hpp"
+
+namespace cn = palisade::gui::layout::constraints;
+
+enum { kColumns, kDock, kMargin, kGutter, kColumnWidth, kStatusBar, kValueCount };
+
+void PhoneLayout::build(System& s, float dpi, bool isLandscape) {
+    s = System{};
+    s.dpi = dpi;
+    s.columns = isLandscape ? 8 : 4;
+    double dp = dpi / 160.0;
+    double cols = s.columns;
+
+    for (cn::Variable* v : {&s.width, &s.height, &s.margin, &s.gutter, &s.columnWidth,
+                            &s.dock, &s.statusBar, &s.content}) {
+        *v = cn::Variable::create();
+    }
+
+    // Horizontal: margins + columns + gutters fill the width
+    s.solver.addConstraint(s.width == s.margin * 2.0 + (s.columnWidth * cols + s.gutter * (cols - 1.0)));
+    s.solver.addConstraint(s.margin >= 8.0 * dp);
+    s.solver.addConstraint(s.gutter >= 4.0 * dp);
+    s.solver.addConstraint(s.columnWidth >= 0.0);
+    s.solver.addConstraint((s.gutter == 16.0 * dp) | cn::strength::strong);
+    s.solver.addConstraint((s.margin == s.width * 0.045) | cn::strength::medium);
+
+    // Vertical: status bar + content + dock fill the height
+    s.solver.addConstraint(s.height == s.statusBar + (s.content + s.dock));
+    s.solver.addConstraint(s.statusBar == 24.0 * dp);
+    s.solver.addConstraint(s.content >= 0.0);
+    s.solver.addConstraint(s.dock >= 56.0 * dp);
+    s.solver.addConstraint(s.dock <= 96.0 * dp);
+    s.solver.addConstraint((s.dock == s.height * 0.08) | cn::strength::medium);
+
+    s.solver.addEditVariable(s.width, cn::strength::strong);
+    s.solver.addEditVariable(s.height, cn::strength::strong);
+    s.ready = true;
+}
+
+static LayoutMetrics toMetrics(const double* v) {
+    LayoutMetrics m{static_cast<int>(v[kColumns]), static_cast<int>(v[kDock] + 0.5), true};
+    m.margin = static_cast<int>(v[kMargin] + 0.5);
+    m.gutter = static_cast<int>(v[kGutter] + 0.5);
+    m.columnWidth = static_cast<int>(v[kColumnWidth]);
+    m.statusBar = static_cast<int>(v[kStatusBar] + 0.5);
+    return m;
+}
+
+LayoutMetrics PhoneLayout::metrics(const DeviceProfile& profile) {
+    bool isLandscape = profile.width > profile.height;
+    uint64_t key = cn::layoutKey(static_cast<int>(profile.type), profile.width, profile.height,
+                                 profile.dpi, isLandscape);
+    double v[kValueCount];
+    if (cn::recall(key, v, kValueCount)) return toMetrics(v);
+
+    // Same orientation and density: only the edit variables move
+    System& s = isLandscape ? landscape : portrait;
+    if (!s.ready || s.dpi != profile.dpi) build(s, profile.dpi, isLandscape);
+    s.solver.suggestValue(s.width, profile.width);
+    s.solver.suggestValue(s.height, profile.height);
+    s.solver.updateVariables();
+
+    v[kColumns] = s.columns;
+    v[kDock] = s.solver.value(s.dock);
+    v[kMargin] = s.solver.value(s.margin);
+    v[kGutter] = s.solver.value(s.gutter);
+    v[kColumnWidth] = s.solver.value(s.columnWidth);
+    v[kStatusBar] = s.solver.value(s.statusBar);
+    cn::store(key, v, kValueCount);
+    return toMetrics(v);
+}
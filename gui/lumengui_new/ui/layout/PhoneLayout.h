@@ -0,0 +1,28 @@
+#pragma once
+#include "LayoutAdapter.h"
+#include "constraints/constraint_solver.hpp"
+
+// Phone metrics from a constraint system (margins, gutters, columns, dock).
+// One incremental solver per orientation: a resize only moves the width/height
+// edit variables. Solved results are memoized per DeviceProfile + orientation,
+// so rotating back and forth is a cache hit.
+class PhoneLayout : public LayoutAdapter {
+public:
+    LayoutMetrics metrics(const DeviceProfile& profile) override;
+
+private:
+    struct System {
+        palisade::gui::layout::constraints::Solver solver;
+        palisade::gui::layout::constraints::Variable width, height;
+        palisade::gui::layout::constraints::Variable margin, gutter, columnWidth;
+        palisade::gui::layout::constraints::Variable dock, statusBar, content;
+        int columns = 0;
+        float dpi = 0.0f;
+        bool ready = false;
+    };
+
+    System portrait;
+    System landscape;
+
+    static void build(System& s, float dpi, bool landscape);
+};
@@ -0,0 +1,60 @@
+#include "adaptive_cache.hpp"
+#include <unordered_map>
+
+namespace palisade::gui::layout::adaptive {
+
+constexpr int kMaxDeviceClasses = 4;
+
+static bool cached = false;
+
+// Keyed by (node, device class): switching device class and back reuses results
+static std::unordered_map<uint64_t, CachedRect> results;
+static size_t hitCount = 0;
+static size_t missCount = 0;
+
+static uint64_t key(uint32_t nodeId, int deviceClass) {
+    return (static_cast<uint64_t>(nodeId) << 8) | static_cast<uint8_t>(deviceClass);
+}
+
+// Marks the tree as fully laid out (nothing dirty until the next invalidate)
+void cacheLayout() {
+    cached = true;
+}
+
+bool isCached() {
+    return cached;
+}
+
+bool lookup(uint32_t nodeId, int deviceClass, CachedRect& out) {
+    auto it = results.find(key(nodeId, deviceClass));
+    if (it == results.end()) {
+        missCount++;
+        return false;
+    }
+    hitCount++;
+    out = it->second;
+    return true;
+}
+
+void store(uint32_t nodeId, int deviceClass, const CachedRect& rect) {
+    results[key(nodeId, deviceClass)] = rect;
+}
+
+// The node's inputs changed: its result is stale for every device class
+void invalidate(uint32_t nodeId) {
+    cached = false;
+    for (int d = 0; d < kMaxDeviceClasses; d++) {
+        results.erase(key(nodeId, d));
+    }
+}
+
+void clear() {
+    cached = false;
+    results.clear();
+}
+
+CacheStats stats() {
+    return {results.size(), hitCount, missCount};
+}
+
+}
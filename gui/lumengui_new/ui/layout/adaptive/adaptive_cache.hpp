@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace palisade::gui::layout::adaptive {
+
+// Computed layout rect of one node for one device class
+struct CachedRect {
+    float x;
+    float y;
+    float w;
+    float h;
+};
+
+struct CacheStats {
+    size_t entries;
+    size_t hits;
+    size_t misses;
+};
+
+void cacheLayout();
+bool isCached();
+
+bool lookup(uint32_t nodeId, int deviceClass, CachedRect& out);
+void store(uint32_t nodeId, int deviceClass, const CachedRect& rect);
+void invalidate(uint32_t nodeId);
+void clear();
+CacheStats stats();
+
+}
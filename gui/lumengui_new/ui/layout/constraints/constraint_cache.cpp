@@ -0,0 +1,62 @@
+#include "constraint_cache.hpp"
+#include <string.h>
+#include <unordered_map>
+
+namespace palisade::gui::layout::constraints {
+
+struct CachedLayout {
+    double values[kMaxCachedValues];
+    size_t count;
+};
+
+// Solved variable values per (profile, orientation): rotating back is a lookup
+static std::unordered_map<uint64_t, CachedLayout> layouts;
+static size_t hitCount = 0;
+static size_t missCount = 0;
+
+uint64_t layoutKey(int deviceType, int width, int height, float dpi, bool landscape) {
+    uint32_t dpiBits;
+    memcpy(&dpiBits, &dpi, sizeof(dpiBits));
+    uint64_t h = 1469598103934665603ULL;  // FNV-1a over the fields
+    for (uint64_t v : {static_cast<uint64_t>(deviceType), static_cast<uint64_t>(width),
+                       static_cast<uint64_t>(height), static_cast<uint64_t>(dpiBits),
+                       static_cast<uint64_t>(landscape)}) {
+        h = (h ^ v) * 1099511628211ULL;
+    }
+    return h;
+}
+
+void store(uint64_t key, const double* values, size_t count) {
+    if (count > kMaxCachedValues) return;
+    if (layouts.size() >= kMaxCachedLayouts && !layouts.count(key)) {
+        layouts.clear();  // Profiles rarely change; a full reset is cheaper than LRU bookkeeping
+    }
+    CachedLayout& c = layouts[key];
+    memcpy(c.values, values, count * sizeof(double));
+    c.count = count;
+}
+
+bool recall(uint64_t key, double* values, size_t count) {
+    auto it = layouts.find(key);
+    if (it == layouts.end() || it->second.count != count) {
+        missCount++;
+        return false;
+    }
+    hitCount++;
+    memcpy(values, it->second.values, count * sizeof(double));
+    return true;
+}
+
+void clear() {
+    layouts.clear();
+}
+
+size_t hits() {
+    return hitCount;
+}
+
+size_t misses() {
+    return missCount;
+}
+
+}
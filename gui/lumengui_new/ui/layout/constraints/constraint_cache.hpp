@@ -0,0 +1,19 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+namespace palisade::gui::layout::constraints {
+
+constexpr size_t kMaxCachedValues = 16;
+constexpr size_t kMaxCachedLayouts = 64;
+
+// Key for one solved layout: device type, size, density and orientation
+uint64_t layoutKey(int deviceType, int width, int height, float dpi, bool landscape);
+
+void store(uint64_t key, const double* values, size_t count);
+bool recall(uint64_t key, double* values, size_t count);
+void clear();
+size_t hits();
+size_t misses();
+
+}
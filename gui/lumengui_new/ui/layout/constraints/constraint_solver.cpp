@@ -0,0 +1,330 @@
+#include "constraint_solver.hpp"
+#include <limits>
+
+namespace palisade::gui::layout::constraints {
+
+static bool nearZero(double v) {
+    const double eps = 1.0e-8;
+    return v < 0.0 ? -v < eps : v < eps;
+}
+
+// ---- Row ----
+
+void Solver::Row::insert(const Symbol& s, double coeff) {
+    double& c = cells[s];
+    c += coeff;
+    if (nearZero(c)) cells.erase(s);
+}
+
+void Solver::Row::insert(const Row& other, double coeff) {
+    constant += other.constant * coeff;
+    for (const auto& [s, c] : other.cells) insert(s, c * coeff);
+}
+
+void Solver::Row::reverseSign() {
+    constant = -constant;
+    for (auto& cell : cells) cell.second = -cell.second;
+}
+
+// Rewrites "0 = row" as "s = row'"
+void Solver::Row::solveFor(const Symbol& s) {
+    double coeff = -1.0 / cells[s];
+    cells.erase(s);
+    constant *= coeff;
+    for (auto& cell : cells) cell.second *= coeff;
+}
+
+// Rewrites "lhs = row" (row contains rhs) as "rhs = row'"
+void Solver::Row::solveFor(const Symbol& lhs, const Symbol& rhs) {
+    insert(lhs, -1.0);
+    solveFor(rhs);
+}
+
+double Solver::Row::coefficientFor(const Symbol& s) const {
+    auto it = cells.find(s);
+    return it == cells.end() ? 0.0 : it->second;
+}
+
+void Solver::Row::substitute(const Symbol& s, const Row& row) {
+    auto it = cells.find(s);
+    if (it == cells.end()) return;
+    double coeff = it->second;
+    cells.erase(it);
+    insert(row, coeff);
+}
+
+// ---- Solver ----
+
+Solver::Symbol Solver::varSymbol(Variable v) {
+    auto it = vars.find(v.id);
+    if (it != vars.end()) return it->second;
+    Symbol s = makeSymbol(Symbol::External);
+    vars[v.id] = s;
+    return s;
+}
+
+SolveResult Solver::addConstraint(const Constraint& c) {
+    if (constraintTags.count(c.id)) return SolveResult::Duplicate;
+
+    Tag tag;
+    Row row = createRow(c, tag);
+    Symbol subject = chooseSubject(row, tag);
+
+    if (subject.type == Symbol::Invalid && allDummies(row)) {
+        if (!nearZero(row.constant)) return SolveResult::Unsatisfiable;
+        subject = tag.marker;
+    }
+
+    if (subject.type == Symbol::Invalid) {
+        if (!addWithArtificialVariable(row)) return SolveResult::Unsatisfiable;
+    } else {
+        row.solveFor(subject);
+        substitute(subject, row);
+        rows[subject] = row;
+    }
+
+    constraintTags[c.id] = tag;
+    optimize(objective);
+    return SolveResult::Ok;
+}
+
+SolveResult Solver::addEditVariable(Variable v, double s) {
+    if (edits.count(v.id)) return SolveResult::Duplicate;
+    s = strength::clip(s);
+    if (s >= strength::required) return SolveResult::BadStrength;
+
+    Constraint c(Expression(v), RelOp::Equal, s);
+    SolveResult r = addConstraint(c);
+    if (r != SolveResult::Ok) return r;
+    edits[v.id] = {constraintTags[c.id], 0.0};
+    return SolveResult::Ok;
+}
+
+SolveResult Solver::suggestValue(Variable v, double value) {
+    auto it = edits.find(v.id);
+    if (it == edits.end()) return SolveResult::UnknownEdit;
+
+    EditInfo& info = it->second;
+    double delta = value - info.constant;
+    info.constant = value;
+    if (nearZero(delta)) return SolveResult::Ok;
+
+    // Marker basic: only its own row moves
+    auto row = rows.find(info.tag.marker);
+    if (row != rows.end()) {
+        if (row->second.add(-delta) < 0.0) infeasible.push_back(row->first);
+        dualOptimize();
+        return SolveResult::Ok;
+    }
+    row = rows.find(info.tag.other);
+    if (row != rows.end()) {
+        if (row->second.add(delta) < 0.0) infeasible.push_back(row->first);
+        dualOptimize();
+        return SolveResult::Ok;
+    }
+
+    // Marker parametric: shift the rows that reference it
+    for (auto& [sym, r] : rows) {
+        double coeff = r.coefficientFor(info.tag.marker);
+        if (coeff != 0.0 && r.add(delta * coeff) < 0.0 && sym.type != Symbol::External) {
+            infeasible.push_back(sym);
+        }
+    }
+    dualOptimize();
+    return SolveResult::Ok;
+}
+
+void Solver::updateVariables() {
+    for (const auto& [id, sym] : vars) {
+        auto it = rows.find(sym);
+        values[id] = it == rows.end() ? 0.0 : it->second.constant;
+    }
+}
+
+double Solver::value(Variable v) const {
+    auto it = values.find(v.id);
+    return it == values.end() ? 0.0 : it->second;
+}
+
+Solver::Row Solver::createRow(const Constraint& c, Tag& tag) {
+    Row row;
+    row.constant = c.expr.constant;
+
+    for (const Term& t : c.expr.terms) {
+        if (nearZero(t.coeff)) continue;
+        Symbol s = varSymbol(t.var);
+        auto basic = rows.find(s);
+        if (basic != rows.end()) row.insert(basic->second, t.coeff);
+        else row.insert(s, t.coeff);
+    }
+
+    switch (c.op) {
+    case RelOp::LessEq:
+    case RelOp::GreaterEq: {
+        double coeff = c.op == RelOp::LessEq ? 1.0 : -1.0;
+        Symbol slack = makeSymbol(Symbol::Slack);
+        tag.marker = slack;
+        row.insert(slack, coeff);
+        if (c.strength < strength::required) {
+            Symbol error = makeSymbol(Symbol::Error);
+            tag.other = error;
+            row.insert(error, -coeff);
+            objective.insert(error, c.strength);
+        }
+        break;
+    }
+    case RelOp::Equal:
+        if (c.strength < strength::required) {
+            Symbol errPlus = makeSymbol(Symbol::Error);
+            Symbol errMinus = makeSymbol(Symbol::Error);
+            tag.marker = errPlus;
+            tag.other = errMinus;
+            row.insert(errPlus, -1.0);
+            row.insert(errMinus, 1.0);
+            objective.insert(errPlus, c.strength);
+            objective.insert(errMinus, c.strength);
+        } else {
+            Symbol dummy = makeSymbol(Symbol::Dummy);
+            tag.marker = dummy;
+            row.insert(dummy);
+        }
+        break;
+    }
+
+    if (row.constant < 0.0) row.reverseSign();
+    return row;
+}
+
+Solver::Symbol Solver::chooseSubject(const Row& row, const Tag& tag) const {
+    for (const auto& cell : row.cells) {
+        if (cell.first.type == Symbol::External) return cell.first;
+    }
+    auto pivotable = [](const Symbol& s) { return s.type == Symbol::Slack || s.type == Symbol::Error; };
+    if (pivotable(tag.marker) && row.coefficientFor(tag.marker) < 0.0) return tag.marker;
+    if (pivotable(tag.other) && row.coefficientFor(tag.other) < 0.0) return tag.other;
+    return {};
+}
+
+bool Solver::addWithArtificialVariable(const Row& row) {
+    Symbol art = makeSymbol(Symbol::Slack);
+    rows[art] = row;
+    artificial = std::make_unique<Row>(row);
+
+    optimize(*artificial);
+    bool success = nearZero(artificial->constant);
+    artificial.reset();
+
+    auto it = rows.find(art);
+    if (it != rows.end()) {
+        Row r = it->second;
+        rows.erase(it);
+        if (r.cells.empty()) return success;
+        Symbol entering = anyPivotableSymbol(r);
+        if (entering.type == Symbol::Invalid) return false;
+        r.solveFor(art, entering);
+        substitute(entering, r);
+        rows[entering] = r;
+    }
+
+    for (auto& entry : rows) entry.second.remove(art);
+    objective.remove(art);
+    return success;
+}
+
+void Solver::substitute(const Symbol& s, const Row& row) {
+    for (auto& [sym, r] : rows) {
+        r.substitute(s, row);
+        if (sym.type != Symbol::External && r.constant < 0.0) infeasible.push_back(sym);
+    }
+    objective.substitute(s, row);
+    if (artificial) artificial->substitute(s, row);
+}
+
+// Primal simplex on the given objective
+void Solver::optimize(Row& obj) {
+    for (;;) {
+        Symbol entering = enteringSymbol(obj);
+        if (entering.type == Symbol::Invalid) return;
+        auto it = leavingRow(entering);
+        if (it == rows.end()) return;  // Unbounded objective; cannot happen for error terms
+        Symbol leaving = it->first;
+        Row r = it->second;
+        rows.erase(it);
+        r.solveFor(leaving, entering);
+        substitute(entering, r);
+        rows[entering] = r;
+    }
+}
+
+// Dual simplex: restores feasibility after suggestValue() moved row constants
+void Solver::dualOptimize() {
+    while (!infeasible.empty()) {
+        Symbol leaving = infeasible.back();
+        infeasible.pop_back();
+        auto it = rows.find(leaving);
+        if (it == rows.end() || nearZero(it->second.constant) || it->second.constant >= 0.0) continue;
+
+        Symbol entering = dualEnteringSymbol(it->second);
+        if (entering.type == Symbol::Invalid) continue;  // Dual infeasible; leave as is
+        Row r = it->second;
+        rows.erase(it);
+        r.solveFor(leaving, entering);
+        substitute(entering, r);
+        rows[entering] = r;
+    }
+}
+
+Solver::Symbol Solver::enteringSymbol(const Row& obj) const {
+    for (const auto& [s, c] : obj.cells) {
+        if (s.type != Symbol::Dummy && c < 0.0) return s;
+    }
+    return {};
+}
+
+Solver::Symbol Solver::dualEnteringSymbol(const Row& row) const {
+    Symbol entering;
+    double ratio = std::numeric_limits<double>::max();
+    for (const auto& [s, c] : row.cells) {
+        if (c > 0.0 && s.type != Symbol::Dummy) {
+            double r = objective.coefficientFor(s) / c;
+            if (r < ratio) {
+                ratio = r;
+                entering = s;
+            }
+        }
+    }
+    return entering;
+}
+
+Solver::Symbol Solver::anyPivotableSymbol(const Row& row) const {
+    for (const auto& cell : row.cells) {
+        if (cell.first.type == Symbol::Slack || cell.first.type == Symbol::Error) return cell.first;
+    }
+    return {};
+}
+
+std::map<Solver::Symbol, Solver::Row>::iterator Solver::leavingRow(const Symbol& entering) {
+    double ratio = std::numeric_limits<double>::max();
+    auto found = rows.end();
+    for (auto it = rows.begin(); it != rows.end(); ++it) {
+        if (it->first.type == Symbol::External) continue;
+        double coeff = it->second.coefficientFor(entering);
+        if (coeff < 0.0) {
+            double r = -it->second.constant / coeff;
+            if (r < ratio) {
+                ratio = r;
+                found = it;
+            }
+        }
+    }
+    return found;
+}
+
+bool Solver::allDummies(const Row& row) {
+    for (const auto& cell : row.cells) {
+        if (cell.first.type != Symbol::Dummy) return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <map>
+#include <memory>
+#include <vector>
+#include "constraint_types.hpp"
+
+namespace palisade::gui::layout::constraints {
+
+enum class SolveResult {
+    Ok,
+    Duplicate,
+    Unsatisfiable,      // Required constraint conflicts with the tableau
+    UnknownEdit,
+    BadStrength,        // Edit variables cannot be required
+};
+
+// Incremental simplex solver (Cassowary). Constraints are added once; edit
+// variables are then moved with suggestValue(), which only touches the rows
+// that reference the edit's error symbols and restores feasibility with the
+// dual simplex, so a resize is a few row updates instead of a rebuild.
+class Solver {
+public:
+    SolveResult addConstraint(const Constraint& c);
+    SolveResult addEditVariable(Variable v, double strength);
+    SolveResult suggestValue(Variable v, double value);
+    void updateVariables();
+    double value(Variable v) const;
+
+private:
+    struct Symbol {
+        enum Type : uint8_t { Invalid, External, Slack, Error, Dummy };
+        uint64_t id = 0;
+        Type type = Invalid;
+        bool operator<(const Symbol& o) const { return id < o.id; }
+        bool operator==(const Symbol& o) const { return id == o.id; }
+    };
+
+    struct Row {
+        std::map<Symbol, double> cells;
+        double constant = 0.0;
+
+        double add(double v) { return constant += v; }
+        void insert(const Symbol& s, double coeff = 1.0);
+        void insert(const Row& other, double coeff = 1.0);
+        void remove(const Symbol& s) { cells.erase(s); }
+        void reverseSign();
+        void solveFor(const Symbol& s);
+        void solveFor(const Symbol& lhs, const Symbol& rhs);
+        double coefficientFor(const Symbol& s) const;
+        void substitute(const Symbol& s, const Row& row);
+    };
+
+    struct Tag {
+        Symbol marker;
+        Symbol other;
+    };
+
+    struct EditInfo {
+        Tag tag;
+        double constant = 0.0;
+    };
+
+    std::map<Symbol, Row> rows;             // Basic symbol -> row
+    std::map<uint32_t, Symbol> vars;        // Variable id -> external symbol
+    std::map<uint32_t, Tag> constraintTags; // Constraint id -> tag
+    std::map<uint32_t, EditInfo> edits;     // Variable id -> edit
+    std::map<uint32_t, double> values;
+    std::vector<Symbol> infeasible;
+    Row objective;
+    std::unique_ptr<Row> artificial;
+    uint64_t idTick = 1;
+
+    Symbol makeSymbol(Symbol::Type t) { return {idTick++, t}; }
+    Symbol varSymbol(Variable v);
+    Row createRow(const Constraint& c, Tag& tag);
+    Symbol chooseSubject(const Row& row, const Tag& tag) const;
+    bool addWithArtificialVariable(const Row& row);
+    void substitute(const Symbol& s, const Row& row);
+    void optimize(Row& obj);
+    void dualOptimize();
+    Symbol enteringSymbol(const Row& obj) const;
+    Symbol dualEnteringSymbol(const Row& row) const;
+    Symbol anyPivotableSymbol(const Row& row) const;
+    std::map<Symbol, Row>::iterator leavingRow(const Symbol& entering);
+    static bool allDummies(const Row& row);
+};
+
+}
@@ -0,0 +1,24 @@
+#include "constraint_types.hpp"
+
+namespace palisade::gui::layout::constraints {
+
+static uint32_t nextVariableId = 1;
+static uint32_t nextConstraintId = 1;
+
+double strength::create(double strong, double medium, double weak, double weight) {
+    auto tier = [](double v) { return v < 0.0 ? 0.0 : (v > 1000.0 ? 1000.0 : v); };
+    return tier(strong * weight) * 1000000.0 + tier(medium * weight) * 1000.0 + tier(weak * weight);
+}
+
+Variable Variable::create() {
+    return {nextVariableId++};
+}
+
+Constraint::Constraint(const Expression& e, RelOp o, double s)
+    : id(nextConstraintId++), expr(e), op(o), strength(strength::clip(s)) {}
+
+bool isFlexible(bool fixed) {
+    return !fixed;
+}
+
+}
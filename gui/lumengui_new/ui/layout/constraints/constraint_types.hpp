@@ -0,0 +1,95 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+
+namespace palisade::gui::layout::constraints {
+
+// Strengths as in Cassowary: required > strong > medium > weak, each tier 1000x
+namespace strength {
+
+double create(double strong, double medium, double weak, double weight = 1.0);
+
+const double required = 1001001000.0;
+const double strong = 1000000.0;
+const double medium = 1000.0;
+const double weak = 1.0;
+
+inline double clip(double s) {
+    return s < 0.0 ? 0.0 : (s > required ? required : s);
+}
+
+}
+
+struct Variable {
+    uint32_t id = 0;
+
+    static Variable create();
+    bool operator<(const Variable& o) const { return id < o.id; }
+};
+
+struct Term {
+    Variable var;
+    double coeff;
+};
+
+// sum(coeff * var) + constant
+struct Expression {
+    std::vector<Term> terms;
+    double constant = 0.0;
+
+    Expression() = default;
+    Expression(double c) : constant(c) {}
+    Expression(Variable v) : terms{{v, 1.0}} {}
+    Expression(Term t) : terms{t} {}
+};
+
+enum class RelOp { LessEq, GreaterEq, Equal };
+
+// expression (op) 0
+struct Constraint {
+    uint32_t id = 0;
+    Expression expr;
+    RelOp op = RelOp::Equal;
+    double strength = strength::required;
+
+    Constraint() = default;
+    Constraint(const Expression& e, RelOp o, double s = strength::required);
+};
+
+bool isFlexible(bool fixed);
+
+// Expression building: (x * 2 + y == width) | strength::strong
+inline Term operator*(Variable v, double c) { return {v, c}; }
+inline Term operator*(double c, Variable v) { return {v, c}; }
+
+inline Expression operator+(Expression a, const Expression& b) {
+    a.terms.insert(a.terms.end(), b.terms.begin(), b.terms.end());
+    a.constant += b.constant;
+    return a;
+}
+
+inline Expression operator*(Expression e, double c) {
+    for (Term& t : e.terms) t.coeff *= c;
+    e.constant *= c;
+    return e;
+}
+
+inline Expression operator-(const Expression& a, const Expression& b) { return a + b * -1.0; }
+inline Expression operator+(Variable a, const Expression& b) { return Expression(a) + b; }
+inline Expression operator+(Term a, const Expression& b) { return Expression(a) + b; }
+inline Expression operator-(Variable a, const Expression& b) { return Expression(a) - b; }
+inline Expression operator-(Term a, const Expression& b) { return Expression(a) - b; }
+
+inline Constraint operator==(const Expression& a, const Expression& b) { return {a - b, RelOp::Equal}; }
+inline Constraint operator<=(const Expression& a, const Expression& b) { return {a - b, RelOp::LessEq}; }
+inline Constraint operator>=(const Expression& a, const Expression& b) { return {a - b, RelOp::GreaterEq}; }
+inline Constraint operator==(Variable a, const Expression& b) { return Expression(a) == b; }
+inline Constraint operator<=(Variable a, const Expression& b) { return Expression(a) <= b; }
+inline Constraint operator>=(Variable a, const Expression& b) { return Expression(a) >= b; }
+
+inline Constraint operator|(Constraint c, double s) {
+    c.strength = strength::clip(s);
+    return c;
+}
+
+}
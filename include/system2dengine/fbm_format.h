@@ -0,0 +1,67 @@
+#ifndef FBM_FORMAT_H
+#define FBM_FORMAT_H
+
+// === LUMEN .fbm Framebuffer Animation Container v1 ===
+// Boot/shutdown style full-screen animations, built by src/system2dengine/tools/fbm_encode.c.
+//
+// Layout (little-endian, every offset from the start of the file):
+//   fbm_header_t
+//   fbm_index_t[frame_count]        Right after the header, so a player can
+//                                   drop consumed frame pages and keep this
+//   frame payloads                  Each a run of tile records
+//
+// A frame is a list of 64x64 tile records in tile order. Keyframes list every
+// non-empty tile and clear the rest; delta frames list only the tiles that
+// changed since the previous frame. Seeking decodes from the closest keyframe.
+//
+// Tile record:
+//   uint16_t tile       Row-major tile index (cols = ceil(width / 64))
+//   uint8_t  codec      FBM_TILE_*
+//   then for FILL: uint32_t color
+//        for RLE:  uint32_t bytes, then the op stream
+//
+// RLE op stream over the tile's pixels in row order (edge tiles are clipped
+// to the image, runs may cross rows):
+//   0x80 | (n - 1), color      Run of n (1..128) pixels
+//   0x00 | (n - 1), n colors   n (1..128) literal pixels
+
+#include <stdint.h>
+
+#define FBM_MAGIC        0x4D42464C  // "LFBM"
+#define FBM_VERSION      1
+#define FBM_TILE_SIZE    64
+
+#define FBM_FLAG_LOOP    (1 << 0)
+
+#define FBM_FRAME_DELTA  0
+#define FBM_FRAME_KEY    1
+
+#define FBM_TILE_EMPTY   0   // Fully transparent
+#define FBM_TILE_FILL    1   // One color
+#define FBM_TILE_RLE     2
+
+#define FBM_RLE_RUN      0x80
+#define FBM_RLE_MAX      128
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;
+    uint16_t width, height;
+    uint16_t fps;
+    uint16_t tile_size;      // Always FBM_TILE_SIZE
+    uint32_t frame_count;
+    uint32_t index_offset;
+    uint32_t data_offset;    // First frame payload
+    uint32_t max_frame_bytes;
+} fbm_header_t;
+
+typedef struct {
+    uint32_t offset;
+    uint32_t size;
+    uint16_t tiles;          // Tile records in the frame
+    uint8_t type;            // FBM_FRAME_*
+    uint8_t reserved;
+} fbm_index_t;
+
+#endif // FBM_FORMAT_H
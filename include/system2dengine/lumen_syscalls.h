@@ -22,6 +22,11 @@ static inline long lumen_syscall1(long n, long a1) {
 #define LUMEN_SYSCALL_FB_SWAP     303
 #define LUMEN_SYSCALL_AUDIO_INIT  310
 #define LUMEN_SYSCALL_AUDIO_WRITE 311
+#define LUMEN_SYSCALL_MMAP_HUGE   320
+#define LUMEN_SYSCALL_MUNMAP_HUGE 321
+#define LUMEN_SYSCALL_FILE_MAP    330  // (path, size_t* size) -> read-only mapping
+#define LUMEN_SYSCALL_FILE_UNMAP  331
+#define LUMEN_SYSCALL_FILE_DROP   332  // Release clean pages of a file mapping
 
 #endif
 
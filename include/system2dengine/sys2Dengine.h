@@ -19,7 +19,26 @@ void sys2d_render_sync(void);  // Main 60FPS VSYNC render loop
 
 // Layers & Compositing
 int sys2d_create_layer(rect_t bounds, int layer_id);
+void sys2d_destroy_layer(int layer_id);
 void sys2d_set_layer_dirty(int layer_id);
+int sys2d_set_layer_tiled(int layer_id, int enable);  // Sparse 64x64 tile storage
+void sys2d_set_layer_compress_delay(uint32_t ms);     // Pack hidden layers after ms (0 = off)
+void sys2d_layer_store_bench(void);
+
+// External layer storage: the layer composites straight from caller-owned
+// pixels (e.g. a Wayland client's shm pool), which must stay mapped until
+// detach or the next attach. stride is in pixels.
+#define SYS2D_LAYER_OPAQUE  (1 << 0)  // Ignore source alpha (XRGB)
+
+int sys2d_layer_attach(int layer_id, color_t* pixels, uint32_t stride, int w, int h, int flags);
+void sys2d_layer_detach(int layer_id);
+void sys2d_layer_damage(int layer_id, rect_t r);     // Layer pixels; narrows the next composite
+void sys2d_set_layer_position(int layer_id, int x, int y);
+
+// Pixel Buffer Pool (64-byte aligned rows, size-class recycling)
+void sys2d_set_hugepages(int enable);
+void sys2d_pixbuf_trim(void);
+void sys2d_pixbuf_stats(void);
 
 // Glassmorphism Effects
 int sys_glass_create_layer(rect_t bounds, float corner_radius, uint8_t blur_radius);
@@ -39,11 +58,93 @@ void sys2d_enable_chaos_events(int enable);
 void sys2d_force_funny_event(int event_id);
 void sys2d_force_chaos_event(int event_id);
 
+// Animations (SoA store stepped once per frame; results go straight into
+// layer properties and only layers whose value changed are marked dirty)
+typedef enum {
+    SYS2D_EASE_LINEAR = 0,  // Fade, scale
+    SYS2D_EASE_IN_QUAD,     // Slide
+    SYS2D_EASE_OUT_QUAD,
+    SYS2D_EASE_SMOOTH,      // Smoothstep
+    SYS2D_EASE_BOUNCE,      // 1 - |sin(2*pi*t)| * (1 - t)
+    SYS2D_EASE_WAVE,        // sin(2*pi*t), for pulses (ends where it started)
+    SYS2D_EASE_NUM
+} sys2d_ease_t;
+
+typedef enum {
+    SYS2D_PROP_ALPHA = 0,   // 0..1
+    SYS2D_PROP_X,           // Translation in pixels
+    SYS2D_PROP_Y,
+    SYS2D_PROP_SCALE,       // Uniform, about the layer origin
+    SYS2D_PROP_NUM
+} sys2d_prop_t;
+
+#define SYS2D_ANIM_LOOP  (1 << 0)
+
+// Return a handle (>= 0) or -1; value = from + (to - from) * ease(t)
+int sys2d_animate(int layer_id, sys2d_prop_t prop, float from, float to,
+                  uint32_t duration_ms, sys2d_ease_t ease, int flags);
+int sys2d_animate_value(float* value, float from, float to,  // *value must outlive the animation
+                        uint32_t duration_ms, sys2d_ease_t ease, int flags);
+void sys2d_anim_cancel(int handle);
+float sys2d_anim_progress(int handle);  // 0..1, or -1 once finished/cancelled
+uint32_t sys2d_anim_count(void);
+void sys2d_anim_bench(void);
+
+// Framebuffer Animations (.fbm, see fbm_format.h): streamed from a mapped
+// file into a tiled layer at the file's fps, decoding only changed tiles
+#define SYS2D_FBM_LOOP  (1 << 0)  // Loop even if the file doesn't ask to
+
+int sys2d_fbm_play(const char* path, int layer_id, int flags);  // Player id or -1
+int sys2d_fbm_seek(int player, uint32_t frame);
+void sys2d_fbm_stop(int player);
+int sys2d_fbm_playing(int player);
+void sys2d_fbm_bench(const char* path);
+
+// Memory Accounting (every engine allocation is tagged by subsystem)
+typedef enum {
+    SYS2D_MEM_LAYERS = 0,   // Compositor layers
+    SYS2D_MEM_GLASS,        // Glass buffers + backdrops + blur scratch
+    SYS2D_MEM_CHAOS,        // Chaos event layers + particles
+    SYS2D_MEM_FUNNY,        // Funny event layers
+    SYS2D_MEM_FPS,          // FPS overlay
+    SYS2D_MEM_POPUP,        // Motivation popup
+    SYS2D_MEM_FREEZE,       // Freeze warning layer + noise pattern
+    SYS2D_MEM_AUDIO,        // Mixer + beep buffers
+    SYS2D_MEM_GUI,          // GUI elements + hit-test grid
+    SYS2D_MEM_ANIM,         // Animation store
+    SYS2D_MEM_POOL_IDLE,    // Freed pixel buffers cached by the pool
+    SYS2D_MEM_NUM_TAGS
+} sys2d_mem_tag_t;
+
+typedef struct {
+    uint64_t live_bytes;
+    uint64_t peak_bytes;    // High-water mark
+    uint32_t alloc_count;   // Total allocations
+    uint32_t free_count;
+    uint32_t live_allocs;
+} sys2d_mem_stats_t;
+
+int sys2d_mem_query(sys2d_mem_tag_t tag, sys2d_mem_stats_t* out);
+void sys2d_mem_total(sys2d_mem_stats_t* out);
+const char* sys2d_mem_tag_name(sys2d_mem_tag_t tag);
+void sys2d_mem_reset_peaks(void);
+void sys2d_mem_stats(void);
+
 // Debug & Monitoring
+typedef enum {
+    SYS2D_HUD_FRAME,        // Frame time, ms (sampled by the engine)
+    SYS2D_HUD_MEMORY,       // Live engine memory, MB (sampled by the engine)
+    SYS2D_HUD_IPC,          // IPC round trip, us (fed by callers)
+    SYS2D_HUD_NUM_GRAPHS
+} sys2d_hud_graph_t;
+
 void sys2d_set_fps_display(int enable);
 void sys2d_toggle_fps_display(void);
+void sys2d_hud_sample(sys2d_hud_graph_t graph, float value);
+void sys2d_hud_bench(void);
 void sys2d_debug_stats(void);
 void sys2d_neon_stats(void);
+void sys2d_gui_hit_bench(void);
 void sys2d_force_freeze_recovery(void);
 
 // Input
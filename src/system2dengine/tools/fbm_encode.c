@@ -0,0 +1,211 @@
+// fbm_encode.c - Build-host tool: raw ARGB8888 frames -> .fbm (fbm_format.h)
+// Usage: fbm_encode <width> <height> <fps> <in.argb> <out.fbm> [--key N] [--loop]
+// Frames are read back to back from in.argb (width*height native-endian pixels
+// each). Every tile that differs from the previous frame is re-encoded; a
+// keyframe is written every N frames (default: one per second) or when more
+// than half the tiles changed anyway.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../../include/system2dengine/fbm_format.h"
+
+typedef struct {
+    uint8_t* data;
+    size_t size, capacity;
+} buf_t;
+
+static void buf_put(buf_t* b, const void* p, size_t n) {
+    if (b->size + n > b->capacity) {
+        size_t cap = b->capacity ? b->capacity * 2 : 1 << 16;
+        while (cap < b->size + n) cap *= 2;
+        b->data = realloc(b->data, cap);
+        if (!b->data) {
+            fprintf(stderr, "fbm_encode: out of memory\n");
+            exit(1);
+        }
+        b->capacity = cap;
+    }
+    memcpy(b->data + b->size, p, n);
+    b->size += n;
+}
+
+static void buf_u8(buf_t* b, uint8_t v) { buf_put(b, &v, 1); }
+static void buf_u16(buf_t* b, uint16_t v) { buf_put(b, &v, 2); }
+static void buf_u32(buf_t* b, uint32_t v) { buf_put(b, &v, 4); }
+
+// Gather a clipped tile into a dense tw*th array (the order the op stream uses)
+static void tile_gather(const uint32_t* frame, int width, int tx, int ty, int tw, int th, uint32_t* out) {
+    for (int y = 0; y < th; y++) {
+        memcpy(out + y * tw, frame + (size_t)(ty * FBM_TILE_SIZE + y) * width + tx * FBM_TILE_SIZE,
+               tw * sizeof(uint32_t));
+    }
+}
+
+// Runs of 2+ equal pixels become run ops; everything else is batched into literals
+static void rle_encode(const uint32_t* px, int n, buf_t* out) {
+    int i = 0;
+    while (i < n) {
+        int run = 1;
+        while (i + run < n && run < FBM_RLE_MAX && px[i + run] == px[i]) run++;
+        if (run >= 2) {
+            buf_u8(out, FBM_RLE_RUN | (run - 1));
+            buf_u32(out, px[i]);
+            i += run;
+            continue;
+        }
+        int lit = 1;
+        while (i + lit < n && lit < FBM_RLE_MAX && !(i + lit + 1 < n && px[i + lit] == px[i + lit + 1])) lit++;
+        buf_u8(out, lit - 1);
+        buf_put(out, px + i, lit * sizeof(uint32_t));
+        i += lit;
+    }
+}
+
+static void tile_encode(const uint32_t* px, int n, uint16_t index, buf_t* frame, buf_t* scratch) {
+    buf_u16(frame, index);
+    int uniform = 1;
+    for (int i = 1; i < n && uniform; i++) uniform = px[i] == px[0];
+    if (uniform && !px[0]) {
+        buf_u8(frame, FBM_TILE_EMPTY);
+    } else if (uniform) {
+        buf_u8(frame, FBM_TILE_FILL);
+        buf_u32(frame, px[0]);
+    } else {
+        scratch->size = 0;
+        rle_encode(px, n, scratch);
+        buf_u8(frame, FBM_TILE_RLE);
+        buf_u32(frame, (uint32_t)scratch->size);
+        buf_put(frame, scratch->data, scratch->size);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 6) {
+        fprintf(stderr, "usage: fbm_encode <width> <height> <fps> <in.argb> <out.fbm> [--key N] [--loop]\n");
+        return 2;
+    }
+    int width = atoi(argv[1]), height = atoi(argv[2]), fps = atoi(argv[3]);
+    int key_interval = fps, flags = 0;
+    for (int i = 6; i < argc; i++) {
+        if (!strcmp(argv[i], "--key") && i + 1 < argc) key_interval = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--loop")) flags |= FBM_FLAG_LOOP;
+    }
+    if (width <= 0 || height <= 0 || width > 65535 || height > 65535 || fps <= 0 || key_interval <= 0) {
+        fprintf(stderr, "fbm_encode: bad size/fps/key interval\n");
+        return 2;
+    }
+    int cols = (width + FBM_TILE_SIZE - 1) / FBM_TILE_SIZE, rows = (height + FBM_TILE_SIZE - 1) / FBM_TILE_SIZE;
+    if (cols * rows > 65535) {
+        fprintf(stderr, "fbm_encode: too many tiles\n");
+        return 2;
+    }
+
+    FILE* in = fopen(argv[4], "rb");
+    if (!in) {
+        perror(argv[4]);
+        return 1;
+    }
+    size_t frame_px = (size_t)width * height;
+    uint32_t* cur = malloc(frame_px * sizeof(uint32_t));
+    uint32_t* prev = malloc(frame_px * sizeof(uint32_t));
+    uint32_t tile_a[FBM_TILE_SIZE * FBM_TILE_SIZE];
+    uint8_t* changed = malloc(cols * rows);
+    buf_t data = {0}, index = {0}, frame = {0}, scratch = {0};
+    uint32_t frames = 0, keys = 0, max_frame = 0;
+    if (!cur || !prev || !changed) return 1;
+
+    while (fread(cur, sizeof(uint32_t), frame_px, in) == frame_px) {
+        int n_changed = 0;
+        for (int ty = 0; ty < rows; ty++) {
+            for (int tx = 0; tx < cols; tx++) {
+                int tw = width - tx * FBM_TILE_SIZE, th = height - ty * FBM_TILE_SIZE;
+                if (tw > FBM_TILE_SIZE) tw = FBM_TILE_SIZE;
+                if (th > FBM_TILE_SIZE) th = FBM_TILE_SIZE;
+                int diff = !frames;
+                for (int y = 0; y < th && !diff; y++) {
+                    size_t o = (size_t)(ty * FBM_TILE_SIZE + y) * width + tx * FBM_TILE_SIZE;
+                    diff = memcmp(cur + o, prev + o, tw * sizeof(uint32_t)) != 0;
+                }
+                changed[ty * cols + tx] = (uint8_t)diff;
+                n_changed += diff;
+            }
+        }
+        int key = frames % key_interval == 0 || n_changed * 2 > cols * rows;
+
+        frame.size = 0;
+        uint16_t records = 0;
+        for (int ti = 0; ti < cols * rows; ti++) {
+            int tx = ti % cols, ty = ti / cols;
+            int tw = width - tx * FBM_TILE_SIZE, th = height - ty * FBM_TILE_SIZE;
+            if (tw > FBM_TILE_SIZE) tw = FBM_TILE_SIZE;
+            if (th > FBM_TILE_SIZE) th = FBM_TILE_SIZE;
+            if (!key && !changed[ti]) continue;
+            tile_gather(cur, width, tx, ty, tw, th, tile_a);
+            if (key) {  // Keyframes skip empty tiles, the decoder clears them
+                int empty = 1;
+                for (int i = 0; i < tw * th && empty; i++) empty = !tile_a[i];
+                if (empty) continue;
+            }
+            tile_encode(tile_a, tw * th, (uint16_t)ti, &frame, &scratch);
+            records++;
+        }
+
+        fbm_index_t e = {(uint32_t)data.size, (uint32_t)frame.size, records,
+                         (uint8_t)(key ? FBM_FRAME_KEY : FBM_FRAME_DELTA), 0};
+        buf_put(&index, &e, sizeof(e));
+        buf_put(&data, frame.data, frame.size);
+        if (frame.size > max_frame) max_frame = (uint32_t)frame.size;
+        keys += key;
+        frames++;
+        uint32_t* t = prev;
+        prev = cur;
+        cur = t;
+    }
+    fclose(in);
+    if (!frames) {
+        fprintf(stderr, "fbm_encode: no complete frames in %s\n", argv[4]);
+        return 1;
+    }
+
+    // Index entries were written relative to the payload; rebase to the file
+    fbm_header_t hdr = {0};
+    hdr.magic = FBM_MAGIC;
+    hdr.version = FBM_VERSION;
+    hdr.flags = (uint16_t)flags;
+    hdr.width = (uint16_t)width;
+    hdr.height = (uint16_t)height;
+    hdr.fps = (uint16_t)fps;
+    hdr.tile_size = FBM_TILE_SIZE;
+    hdr.frame_count = frames;
+    hdr.index_offset = sizeof(fbm_header_t);
+    hdr.data_offset = (uint32_t)(sizeof(fbm_header_t) + index.size);
+    hdr.max_frame_bytes = max_frame;
+    fbm_index_t* entries = (fbm_index_t*)index.data;
+    for (uint32_t i = 0; i < frames; i++) entries[i].offset += hdr.data_offset;
+
+    FILE* out = fopen(argv[5], "wb");
+    if (!out) {
+        perror(argv[5]);
+        return 1;
+    }
+    fwrite(&hdr, sizeof(hdr), 1, out);
+    fwrite(index.data, 1, index.size, out);
+    fwrite(data.data, 1, data.size, out);
+    if (fclose(out) != 0) {
+        perror(argv[5]);
+        return 1;
+    }
+
+    printf("%s: %ux%u, %u frames (%u key), %zu KB (raw %zu KB)\n", argv[5], width, height, frames, keys,
+           (sizeof(hdr) + index.size + data.size) >> 10, (frame_px * 4 * frames) >> 10);
+    free(cur);
+    free(prev);
+    free(changed);
+    free(data.data);
+    free(index.data);
+    free(frame.data);
+    free(scratch.data);
+    return 0;
+}